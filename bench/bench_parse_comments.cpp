@@ -0,0 +1,47 @@
+#include <toml.hpp>
+
+#include "bench_utility.hpp"
+
+#include <cstdlib>
+
+namespace
+{
+struct discard_comments_config : toml::type_config
+{
+    using comment_type = toml::discard_comments;
+};
+} // anonymous
+
+int main(int argc, char** argv)
+{
+    const std::size_t n_tables = (argc >= 2) ? std::strtoul(argv[1], nullptr, 10) : 20000;
+    const std::size_t n_iter   = (argc >= 3) ? std::strtoul(argv[2], nullptr, 10) : 5;
+
+    // a well-documented configuration file: most of the lines are comments
+    std::string content;
+    for(std::size_t i=0; i<n_tables; ++i)
+    {
+        const auto n = std::to_string(i);
+        content += "# ------------------------------------------------------------\n"
+                   "# section " + n + "\n"
+                   "# ------------------------------------------------------------\n"
+                   "[section" + n + "] # the header comment\n"
+                   "# the number of worker threads. 0 means the number of cores.\n"
+                   "workers = " + n + " # default: 0\n"
+                   "# the list of hosts to connect to, in the order of priority.\n"
+                   "hosts = [\n"
+                   "    \"alpha\", # the primary\n"
+                   "    \"beta\",  # the secondary\n"
+                   "]\n";
+    }
+    std::cout << n_tables << " commented tables, median of " << n_iter << " runs\n";
+
+    std::cout << "\n-- parse --\n";
+    toml_bench::report("preserve_comments", content.size(), toml_bench::measure(n_iter, [&] {
+            const auto v = toml::parse_str(content);
+        }));
+    toml_bench::report("discard_comments", content.size(), toml_bench::measure(n_iter, [&] {
+            const auto v = toml::parse_str<discard_comments_config>(content);
+        }));
+    return 0;
+}
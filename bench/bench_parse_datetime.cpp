@@ -0,0 +1,38 @@
+#include <toml.hpp>
+
+#include "bench_utility.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+int main(int argc, char** argv)
+{
+    const std::size_t n_values = (argc >= 2) ? std::strtoul(argv[1], nullptr, 10) : 200000;
+    const std::size_t n_iter   = (argc >= 3) ? std::strtoul(argv[2], nullptr, 10) : 5;
+
+    std::mt19937_64 rng(123456789);
+    std::uniform_int_distribution<int> day(1, 28);
+    std::uniform_int_distribution<int> sec(0, 86399);
+    std::uniform_int_distribution<int> usec(0, 999999);
+
+    // an event log: an array of offset_datetimes
+    std::string content("events = [\n");
+    for(std::size_t i=0; i<n_values; ++i)
+    {
+        const int s = sec(rng);
+        char buf[64];
+        std::snprintf(buf, sizeof(buf), "  2024-05-%02dT%02d:%02d:%02d.%06d+09:00,\n",
+                day(rng), s / 3600, s / 60 % 60, s % 60, usec(rng));
+        content += buf;
+    }
+    content += "]\n";
+
+    std::cout << n_values << " offset_datetimes, median of " << n_iter << " runs\n";
+
+    std::cout << "\n-- parse --\n";
+    toml_bench::report("toml::parse_str", content.size(), toml_bench::measure(n_iter, [&] {
+            const auto v = toml::parse_str(content);
+        }));
+    return 0;
+}
@@ -0,0 +1,72 @@
+#include <toml.hpp>
+
+#include "bench_utility.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <sstream>
+
+int main(int argc, char** argv)
+{
+    const std::size_t n_values = (argc >= 2) ? std::strtoul(argv[1], nullptr, 10) : 200000;
+    const std::size_t n_iter   = (argc >= 3) ? std::strtoul(argv[2], nullptr, 10) : 5;
+
+    std::mt19937_64 rng(123456789);
+    std::uniform_real_distribution<double> dist(-1e3, 1e3);
+
+    std::vector<std::string> strs;
+    std::size_t total = 0;
+    for(std::size_t i=0; i<n_values; ++i)
+    {
+        char buf[64];
+        std::snprintf(buf, sizeof(buf), "%.17g", dist(rng));
+        strs.emplace_back(buf);
+        total += strs.back().size();
+    }
+    std::cout << n_values << " doubles, median of " << n_iter << " runs\n";
+
+    std::cout << "\n-- read only --\n";
+    toml_bench::report("std::istringstream (previous)", total, toml_bench::measure(n_iter, [&] {
+            double sum = 0.0;
+            for(const auto& s : strs)
+            {
+                double x;
+                std::istringstream iss(s);
+                iss >> x;
+                sum += x;
+            }
+            if(sum == 42.0) {std::abort();}
+        }));
+    toml_bench::report("std::strtod", total, toml_bench::measure(n_iter, [&] {
+            double sum = 0.0;
+            for(const auto& s : strs)
+            {
+                sum += std::strtod(s.c_str(), nullptr);
+            }
+            if(sum == 42.0) {std::abort();}
+        }));
+    const auto loc = toml::detail::make_temporary_location("0");
+    const toml::detail::region reg(loc);
+    toml_bench::report("toml::read_float<double>", total, toml_bench::measure(n_iter, [&] {
+            double sum = 0.0;
+            for(const auto& s : strs)
+            {
+                sum += toml::read_float<double>(s, reg, false).unwrap();
+            }
+            if(sum == 42.0) {std::abort();}
+        }));
+
+    // [[samples]] array of tables that mostly contains floats
+    std::string content;
+    for(std::size_t i=0; i+3<strs.size(); i+=4)
+    {
+        content += "[[samples]]\nt = " + strs[i] + "\nx = " + strs[i+1] +
+                   "\ny = " + strs[i+2] + "\nz = " + strs[i+3] + "\n";
+    }
+    std::cout << "\n-- parse --\n";
+    toml_bench::report("toml::parse_str", content.size(), toml_bench::measure(n_iter, [&] {
+            const auto v = toml::parse_str(content);
+        }));
+    return 0;
+}
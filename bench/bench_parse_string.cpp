@@ -0,0 +1,43 @@
+#include <toml.hpp>
+
+#include "bench_utility.hpp"
+
+#include <cstdlib>
+
+int main(int argc, char** argv)
+{
+    const std::size_t n_values = (argc >= 2) ? std::strtoul(argv[1], nullptr, 10) : 2000;
+    const std::size_t n_iter   = (argc >= 3) ? std::strtoul(argv[2], nullptr, 10) : 5;
+
+    // certificate-like blobs in basic and multi-line basic strings
+    std::string blob;
+    for(std::size_t i=0; blob.size() < 4000; ++i)
+    {
+        blob += static_cast<char>('A' + (i * 7) % 26);
+        if(i % 64 == 63) {blob += "\n";}
+    }
+    std::string line_blob = blob;
+    for(auto& c : line_blob) {if(c == '\n') {c = ' ';}}
+
+    std::string no_escape, ml_no_escape, escaped;
+    for(std::size_t i=0; i<n_values; ++i)
+    {
+        const auto n = std::to_string(i);
+        no_escape    += "s" + n + " = \"" + line_blob + "\"\n";
+        ml_no_escape += "s" + n + " = \"\"\"\n" + blob + "\"\"\"\n";
+        escaped      += "s" + n + " = \"" + line_blob + "\\n\\t\\u00E9\"\n";
+    }
+    std::cout << n_values << " strings of " << line_blob.size()
+              << " bytes, median of " << n_iter << " runs\n";
+
+    toml_bench::report("basic string", no_escape.size(), toml_bench::measure(n_iter, [&] {
+            const auto v = toml::parse_str(no_escape);
+        }));
+    toml_bench::report("multi-line basic string", ml_no_escape.size(), toml_bench::measure(n_iter, [&] {
+            const auto v = toml::parse_str(ml_no_escape);
+        }));
+    toml_bench::report("basic string with escapes", escaped.size(), toml_bench::measure(n_iter, [&] {
+            const auto v = toml::parse_str(escaped);
+        }));
+    return 0;
+}
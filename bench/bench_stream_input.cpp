@@ -0,0 +1,85 @@
+#include <toml.hpp>
+
+#include "bench_utility.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+
+// reads a file the way toml::parse(std::istream&) did before the chunked
+// reader: it seeks to find the size and reads the whole file at once.
+std::vector<unsigned char> read_seek_based(std::istream& is)
+{
+    const auto beg = is.tellg();
+    is.seekg(0, std::ios::end);
+    const auto end = is.tellg();
+    const auto fsize = end - beg;
+    is.seekg(beg);
+
+    std::vector<unsigned char> letters(static_cast<std::size_t>(fsize), '\0');
+    is.read(reinterpret_cast<char*>(letters.data()), static_cast<std::streamsize>(fsize));
+    return letters;
+}
+
+int main(int argc, char** argv)
+{
+    const std::size_t megabytes = (argc >= 2) ? std::strtoul(argv[1], nullptr, 10) : 4;
+    const std::size_t n_iter    = (argc >= 3) ? std::strtoul(argv[2], nullptr, 10) : 5;
+    const std::string fname("bench_stream_input.toml");
+    {
+        std::ofstream ofs(fname, std::ios_base::binary);
+        ofs << toml_bench::make_input(megabytes * 1024 * 1024);
+    }
+    std::size_t fsize = 0;
+    {
+        std::ifstream ifs(fname, std::ios_base::binary | std::ios_base::ate);
+        fsize = static_cast<std::size_t>(ifs.tellg());
+    }
+    std::cout << "input: " << fsize << " bytes, median of " << n_iter << " runs\n";
+
+    std::cout << "\n-- read only --\n";
+    toml_bench::report("seek-based (previous)", fsize, toml_bench::measure(n_iter, [&] {
+            std::ifstream ifs(fname, std::ios_base::binary);
+            const auto buf = read_seek_based(ifs);
+            if(buf.size() != fsize) {std::abort();}
+        }));
+    toml_bench::report("chunked, std::ifstream", fsize, toml_bench::measure(n_iter, [&] {
+            std::ifstream ifs(fname, std::ios_base::binary);
+            const auto buf = toml::detail::read_stream(ifs);
+            if(buf.unwrap().size() != fsize) {std::abort();}
+        }));
+    toml_bench::report("chunked, FILE*", fsize, toml_bench::measure(n_iter, [&] {
+            FILE* fp = std::fopen(fname.c_str(), "rb");
+            const auto buf = toml::detail::read_file(fp);
+            std::fclose(fp);
+            if(buf.unwrap().size() != fsize) {std::abort();}
+        }));
+#if defined(__unix__) || defined(__APPLE__)
+    toml_bench::report("chunked, FILE* (pipe)", fsize, toml_bench::measure(n_iter, [&] {
+            FILE* fp = ::popen(("cat " + fname).c_str(), "r");
+            const auto buf = toml::detail::read_file(fp);
+            ::pclose(fp);
+            if(buf.unwrap().size() != fsize) {std::abort();}
+        }));
+#endif
+
+    std::cout << "\n-- read and parse --\n";
+    toml_bench::report("seek-based (previous)", fsize, toml_bench::measure(n_iter, [&] {
+            std::ifstream ifs(fname, std::ios_base::binary);
+            const auto v = toml::parse(read_seek_based(ifs), fname);
+        }));
+    toml_bench::report("chunked, std::ifstream", fsize, toml_bench::measure(n_iter, [&] {
+            std::ifstream ifs(fname, std::ios_base::binary);
+            const auto v = toml::parse(ifs, fname);
+        }));
+#if defined(__unix__) || defined(__APPLE__)
+    toml_bench::report("chunked, FILE* (pipe)", fsize, toml_bench::measure(n_iter, [&] {
+            FILE* fp = ::popen(("cat " + fname).c_str(), "r");
+            const auto v = toml::parse(fp, "pipe");
+            ::pclose(fp);
+        }));
+#endif
+
+    std::remove(fname.c_str());
+    return 0;
+}
@@ -0,0 +1,65 @@
+#ifndef TOML11_BENCH_UTILITY_HPP
+#define TOML11_BENCH_UTILITY_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <cstddef>
+
+namespace toml_bench
+{
+
+// runs `f` `n` times and returns the median of the elapsed time in seconds.
+template<typename F>
+double measure(const std::size_t n, F&& f)
+{
+    std::vector<double> elapsed;
+    for(std::size_t i=0; i<n; ++i)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        f();
+        const auto stop  = std::chrono::steady_clock::now();
+        elapsed.push_back(std::chrono::duration<double>(stop - start).count());
+    }
+    std::sort(elapsed.begin(), elapsed.end());
+    return elapsed.at(elapsed.size() / 2);
+}
+
+inline void report(const std::string& name, const std::size_t bytes, const double sec)
+{
+    const double mb = static_cast<double>(bytes) / (1024.0 * 1024.0);
+    std::cout << std::left  << std::setw(40) << name
+              << std::right << std::setw(10) << std::fixed << std::setprecision(3)
+              << sec * 1000.0 << " ms "
+              << std::setw(10) << std::setprecision(1) << mb / sec << " MiB/s\n";
+}
+
+// generates a TOML file that contains various kinds of values.
+inline std::string make_input(const std::size_t approx_bytes)
+{
+    std::string content;
+    content.reserve(approx_bytes + 1024);
+    std::size_t i = 0;
+    while(content.size() < approx_bytes)
+    {
+        const auto n = std::to_string(i);
+        content += "[table" + n + "]\n";
+        content += "# comment line\n";
+        content += "integer = " + n + "\n";
+        content += "float   = " + n + ".5e-3\n";
+        content += "string  = \"value " + n + "\" # trailing comment\n";
+        content += "boolean = true\n";
+        content += "date    = 1979-05-27T07:32:00Z\n";
+        content += "array   = [1, 2, 3, 4]\n";
+        content += "inline  = {a = 1, b = \"b\"}\n\n";
+        ++i;
+    }
+    return content;
+}
+
+} // toml_bench
+#endif // TOML11_BENCH_UTILITY_HPP
@@ -33,6 +33,7 @@
 #include "toml11/error_info.hpp"
 #include "toml11/exception.hpp"
 #include "toml11/find.hpp"
+#include "toml11/float_reader.hpp"
 #include "toml11/format.hpp"
 #include "toml11/from.hpp"
 #include "toml11/get.hpp"
@@ -45,9 +46,13 @@
 #include "toml11/result.hpp"
 #include "toml11/scanner.hpp"
 #include "toml11/serializer.hpp"
+#include "toml11/simd.hpp"
 #include "toml11/skip.hpp"
+#include "toml11/source_buffer.hpp"
 #include "toml11/source_location.hpp"
 #include "toml11/spec.hpp"
+#include "toml11/static_scanner.hpp"
+#include "toml11/static_syntax.hpp"
 #include "toml11/storage.hpp"
 #include "toml11/syntax.hpp"
 #include "toml11/traits.hpp"
@@ -0,0 +1,10 @@
+#ifndef TOML11_FLOAT_READER_HPP
+#define TOML11_FLOAT_READER_HPP
+
+#include "fwd/float_reader_fwd.hpp" // IWYU pragma: export
+
+#if ! defined(TOML11_COMPILE_SOURCES)
+#include "impl/float_reader_impl.hpp" // IWYU pragma: export
+#endif
+
+#endif // TOML11_FLOAT_READER_HPP
@@ -7,6 +7,7 @@
 #include <exception>
 #include <initializer_list>
 #include <iterator>
+#include <memory>
 #include <stdexcept>
 #include <string>
 #include <type_traits>
@@ -50,40 +51,58 @@ class preserve_comments
 
     preserve_comments()  = default;
     ~preserve_comments() = default;
-    preserve_comments(preserve_comments const&) = default;
     preserve_comments(preserve_comments &&)     = default;
-    preserve_comments& operator=(preserve_comments const&) = default;
     preserve_comments& operator=(preserve_comments &&)     = default;
 
-    explicit preserve_comments(const std::vector<std::string>& c): comments(c){}
+    preserve_comments(preserve_comments const& other)
+        : comments(other.empty() ? nullptr : new container_type(*other.comments))
+    {}
+    preserve_comments& operator=(preserve_comments const& other)
+    {
+        preserve_comments tmp(other);
+        this->swap(tmp);
+        return *this;
+    }
+
+    explicit preserve_comments(const std::vector<std::string>& c)
+        : comments(c.empty() ? nullptr : new container_type(c))
+    {}
     explicit preserve_comments(std::vector<std::string>&& c)
-        : comments(std::move(c))
+        : comments(c.empty() ? nullptr : new container_type(std::move(c)))
     {}
     preserve_comments& operator=(const std::vector<std::string>& c)
     {
-        comments = c;
+        preserve_comments tmp(c);
+        this->swap(tmp);
         return *this;
     }
     preserve_comments& operator=(std::vector<std::string>&& c)
     {
-        comments = std::move(c);
+        preserve_comments tmp(std::move(c));
+        this->swap(tmp);
         return *this;
     }
 
     explicit preserve_comments(const discard_comments&) {}
 
-    explicit preserve_comments(size_type n): comments(n) {}
-    preserve_comments(size_type n, const std::string& x): comments(n, x) {}
-    preserve_comments(std::initializer_list<std::string> x): comments(x) {}
+    explicit preserve_comments(size_type n)
+        : comments(n == 0 ? nullptr : new container_type(n))
+    {}
+    preserve_comments(size_type n, const std::string& x)
+        : comments(n == 0 ? nullptr : new container_type(n, x))
+    {}
+    preserve_comments(std::initializer_list<std::string> x)
+        : comments(x.size() == 0 ? nullptr : new container_type(x))
+    {}
     template<typename InputIterator>
     preserve_comments(InputIterator first, InputIterator last)
-        : comments(first, last)
+        : comments(first == last ? nullptr : new container_type(first, last))
     {}
 
     template<typename InputIterator>
-    void assign(InputIterator first, InputIterator last) {comments.assign(first, last);}
-    void assign(std::initializer_list<std::string> ini)  {comments.assign(ini);}
-    void assign(size_type n, const std::string& val)     {comments.assign(n, val);}
+    void assign(InputIterator first, InputIterator last) {this->get_or_allocate().assign(first, last);}
+    void assign(std::initializer_list<std::string> ini)  {this->get_or_allocate().assign(ini);}
+    void assign(size_type n, const std::string& val)     {this->get_or_allocate().assign(n, val);}
 
     // Related to the issue #97.
     //
@@ -96,122 +115,129 @@ class preserve_comments
 #  endif
 #endif
 
+    // If nothing is allocated, `p` is begin() == end() of an empty container.
 #ifdef TOML11_WORKAROUND_GCC_4_8_X_STANDARD_LIBRARY_IMPLEMENTATION
     iterator insert(iterator p, const std::string& x)
     {
-        return comments.insert(p, x);
+        return this->allocate_at(p).insert(p, x);
     }
     iterator insert(iterator p, std::string&&      x)
     {
-        return comments.insert(p, std::move(x));
+        return this->allocate_at(p).insert(p, std::move(x));
     }
     void insert(iterator p, size_type n, const std::string& x)
     {
-        return comments.insert(p, n, x);
+        return this->allocate_at(p).insert(p, n, x);
     }
     template<typename InputIterator>
     void insert(iterator p, InputIterator first, InputIterator last)
     {
-        return comments.insert(p, first, last);
+        return this->allocate_at(p).insert(p, first, last);
     }
     void insert(iterator p, std::initializer_list<std::string> ini)
     {
-        return comments.insert(p, ini);
+        return this->allocate_at(p).insert(p, ini);
     }
 
     template<typename ... Ts>
     iterator emplace(iterator p, Ts&& ... args)
     {
-        return comments.emplace(p, std::forward<Ts>(args)...);
+        return this->allocate_at(p).emplace(p, std::forward<Ts>(args)...);
     }
 
-    iterator erase(iterator pos) {return comments.erase(pos);}
+    iterator erase(iterator pos) {return comments->erase(pos);}
     iterator erase(iterator first, iterator last)
     {
-        return comments.erase(first, last);
+        if(first == last) {return last;}
+        return comments->erase(first, last);
     }
 #else
     iterator insert(const_iterator p, const std::string& x)
     {
-        return comments.insert(p, x);
+        return this->allocate_at(p).insert(p, x);
     }
     iterator insert(const_iterator p, std::string&&      x)
     {
-        return comments.insert(p, std::move(x));
+        return this->allocate_at(p).insert(p, std::move(x));
     }
     iterator insert(const_iterator p, size_type n, const std::string& x)
     {
-        return comments.insert(p, n, x);
+        return this->allocate_at(p).insert(p, n, x);
     }
     template<typename InputIterator>
     iterator insert(const_iterator p, InputIterator first, InputIterator last)
     {
-        return comments.insert(p, first, last);
+        return this->allocate_at(p).insert(p, first, last);
     }
     iterator insert(const_iterator p, std::initializer_list<std::string> ini)
     {
-        return comments.insert(p, ini);
+        return this->allocate_at(p).insert(p, ini);
     }
 
     template<typename ... Ts>
     iterator emplace(const_iterator p, Ts&& ... args)
     {
-        return comments.emplace(p, std::forward<Ts>(args)...);
+        return this->allocate_at(p).emplace(p, std::forward<Ts>(args)...);
     }
 
-    iterator erase(const_iterator pos) {return comments.erase(pos);}
+    iterator erase(const_iterator pos) {return comments->erase(pos);}
     iterator erase(const_iterator first, const_iterator last)
     {
-        return comments.erase(first, last);
+        if( ! comments) {return empty_container().begin();}
+        return comments->erase(first, last);
     }
 #endif
 
-    void swap(preserve_comments& other) {comments.swap(other.comments);}
+    void swap(preserve_comments& other) noexcept {comments.swap(other.comments);}
 
-    void push_back(const std::string& v) {comments.push_back(v);}
-    void push_back(std::string&&      v) {comments.push_back(std::move(v));}
-    void pop_back()                      {comments.pop_back();}
+    void push_back(const std::string& v) {this->get_or_allocate().push_back(v);}
+    void push_back(std::string&&      v) {this->get_or_allocate().push_back(std::move(v));}
+    void pop_back()                      {comments->pop_back();}
 
     template<typename ... Ts>
-    void emplace_back(Ts&& ... args) {comments.emplace_back(std::forward<Ts>(args)...);}
-
-    void clear() {comments.clear();}
-
-    size_type size()     const noexcept {return comments.size();}
-    size_type max_size() const noexcept {return comments.max_size();}
-    size_type capacity() const noexcept {return comments.capacity();}
-    bool      empty()    const noexcept {return comments.empty();}
-
-    void reserve(size_type n)                      {comments.reserve(n);}
-    void resize(size_type n)                       {comments.resize(n);}
-    void resize(size_type n, const std::string& c) {comments.resize(n, c);}
-    void shrink_to_fit()                           {comments.shrink_to_fit();}
-
-    reference       operator[](const size_type n)       noexcept {return comments[n];}
-    const_reference operator[](const size_type n) const noexcept {return comments[n];}
-    reference       at(const size_type n)       {return comments.at(n);}
-    const_reference at(const size_type n) const {return comments.at(n);}
-    reference       front()       noexcept {return comments.front();}
-    const_reference front() const noexcept {return comments.front();}
-    reference       back()        noexcept {return comments.back();}
-    const_reference back()  const noexcept {return comments.back();}
-
-    pointer         data()        noexcept {return comments.data();}
-    const_pointer   data()  const noexcept {return comments.data();}
-
-    iterator       begin()        noexcept {return comments.begin();}
-    iterator       end()          noexcept {return comments.end();}
-    const_iterator begin()  const noexcept {return comments.begin();}
-    const_iterator end()    const noexcept {return comments.end();}
-    const_iterator cbegin() const noexcept {return comments.cbegin();}
-    const_iterator cend()   const noexcept {return comments.cend();}
-
-    reverse_iterator       rbegin()        noexcept {return comments.rbegin();}
-    reverse_iterator       rend()          noexcept {return comments.rend();}
-    const_reverse_iterator rbegin()  const noexcept {return comments.rbegin();}
-    const_reverse_iterator rend()    const noexcept {return comments.rend();}
-    const_reverse_iterator crbegin() const noexcept {return comments.crbegin();}
-    const_reverse_iterator crend()   const noexcept {return comments.crend();}
+    void emplace_back(Ts&& ... args) {this->get_or_allocate().emplace_back(std::forward<Ts>(args)...);}
+
+    void clear() {if(comments) {comments->clear();}}
+
+    size_type size()     const noexcept {return this->get().size();}
+    size_type max_size() const noexcept {return this->get().max_size();}
+    size_type capacity() const noexcept {return this->get().capacity();}
+    bool      empty()    const noexcept {return this->get().empty();}
+
+    void reserve(size_type n)                      {if(n != 0) {this->get_or_allocate().reserve(n);}}
+    void resize(size_type n)                       {if(n != 0 || comments) {this->get_or_allocate().resize(n);}}
+    void resize(size_type n, const std::string& c) {if(n != 0 || comments) {this->get_or_allocate().resize(n, c);}}
+    void shrink_to_fit()
+    {
+        if(comments && comments->empty()) {comments.reset();}
+        if(comments) {comments->shrink_to_fit();}
+    }
+
+    reference       operator[](const size_type n)       noexcept {return (*comments)[n];}
+    const_reference operator[](const size_type n) const noexcept {return (*comments)[n];}
+    reference       at(const size_type n)       {return this->get().at(n);}
+    const_reference at(const size_type n) const {return this->get().at(n);}
+    reference       front()       noexcept {return comments->front();}
+    const_reference front() const noexcept {return comments->front();}
+    reference       back()        noexcept {return comments->back();}
+    const_reference back()  const noexcept {return comments->back();}
+
+    pointer         data()        noexcept {return comments ? comments->data() : nullptr;}
+    const_pointer   data()  const noexcept {return comments ? comments->data() : nullptr;}
+
+    iterator       begin()        noexcept {return this->get().begin();}
+    iterator       end()          noexcept {return this->get().end();}
+    const_iterator begin()  const noexcept {return this->get().begin();}
+    const_iterator end()    const noexcept {return this->get().end();}
+    const_iterator cbegin() const noexcept {return this->get().cbegin();}
+    const_iterator cend()   const noexcept {return this->get().cend();}
+
+    reverse_iterator       rbegin()        noexcept {return this->get().rbegin();}
+    reverse_iterator       rend()          noexcept {return this->get().rend();}
+    const_reverse_iterator rbegin()  const noexcept {return this->get().rbegin();}
+    const_reverse_iterator rend()    const noexcept {return this->get().rend();}
+    const_reverse_iterator crbegin() const noexcept {return this->get().crbegin();}
+    const_reverse_iterator crend()   const noexcept {return this->get().crend();}
 
     friend bool operator==(const preserve_comments&, const preserve_comments&);
     friend bool operator!=(const preserve_comments&, const preserve_comments&);
@@ -225,7 +251,42 @@ class preserve_comments
 
   private:
 
-    container_type comments;
+    // Most of the values do not have any comment. To make them small, the
+    // container is allocated when the first comment is added. Until then,
+    // it looks like an empty container that is never modified.
+    static container_type& empty_container() noexcept
+    {
+        static container_type empty;
+        return empty;
+    }
+    container_type const& get() const noexcept
+    {
+        return comments ? *comments : empty_container();
+    }
+    container_type& get() noexcept
+    {
+        return comments ? *comments : empty_container();
+    }
+    container_type& get_or_allocate()
+    {
+        if( ! comments) {comments.reset(new container_type{});}
+        return *comments;
+    }
+    // `p` points the allocated container, or the empty one if not allocated.
+    template<typename Iterator>
+    container_type& allocate_at(Iterator& p)
+    {
+        if( ! comments)
+        {
+            comments.reset(new container_type{});
+            p = comments->begin();
+        }
+        return *comments;
+    }
+
+  private:
+
+    std::unique_ptr<container_type> comments; // nullptr if nothing is added
 };
 
 bool operator==(const preserve_comments& lhs, const preserve_comments& rhs);
@@ -0,0 +1,47 @@
+#ifndef TOML11_FLOAT_READER_FWD_HPP
+#define TOML11_FLOAT_READER_FWD_HPP
+
+#include "../version.hpp"
+
+#include <cstdint>
+
+namespace toml
+{
+inline namespace TOML11_INLINE_VERSION_NAMESPACE
+{
+namespace detail
+{
+
+//
+// Reads a decimal floating-point number `[+-]?[0-9]*(\.[0-9]*)?([eE][+-]?[0-9]+)?`
+// in [first, last) and converts it to the nearest `double` or `float`, without
+// depending on locale or iostream.
+//
+// It uses Clinger's fast path when the value is exactly representable, and
+// Eisel-Lemire algorithm otherwise. If the result cannot be determined by
+// them (e.g. the value is subnormal, out of range, too close to a halfway
+// point, or the string is in an unexpected format), it returns false and
+// leaves `val` unchanged. In that case, the caller should fall back to a
+// slower, arbitrary-precision reader such as `std::strtod`.
+//
+bool read_dec_float_fast(const char* first, const char* last, double& val) noexcept;
+bool read_dec_float_fast(const char* first, const char* last, float&  val) noexcept;
+
+struct uint128_parts
+{
+    std::uint64_t hi;
+    std::uint64_t lo;
+};
+
+// 128-bit truncated mantissa of 10^q, normalized so that the MSB is set.
+// q must be in [min_power_of_ten_128, max_power_of_ten_128].
+constexpr int min_power_of_ten_128 = -342;
+constexpr int max_power_of_ten_128 =  308;
+uint128_parts power_of_ten_128(const int q) noexcept;
+
+uint128_parts multiply_64x64(const std::uint64_t a, const std::uint64_t b) noexcept;
+
+} // detail
+} // TOML11_INLINE_VERSION_NAMESPACE
+} // toml
+#endif // TOML11_FLOAT_READER_FWD_HPP
@@ -2,6 +2,7 @@
 #define TOML11_FORMAT_FWD_HPP
 
 #include <iosfwd>
+#include <memory>
 #include <string>
 #include <utility>
 
@@ -44,6 +45,143 @@ inline bool operator!=(const boolean_format_info&, const boolean_format_info&) n
     return false;
 }
 
+// ----------------------------------------------------------------------------
+// number suffix (library extension)
+
+// A string that holds the suffix of a number, e.g. `sec` of `10_sec`.
+// Since almost all numbers do not have a suffix, it allocates the string only
+// when it is not empty. It keeps the format_info of numbers small.
+class number_suffix
+{
+  public:
+
+    number_suffix() noexcept = default;
+    ~number_suffix() noexcept = default;
+    number_suffix(number_suffix&&) noexcept = default;
+    number_suffix& operator=(number_suffix&&) noexcept = default;
+
+    number_suffix(const number_suffix& other)
+        : str_(other.empty() ? nullptr : new std::string(*other.str_))
+    {}
+    number_suffix& operator=(const number_suffix& other)
+    {
+        number_suffix tmp(other);
+        this->str_ = std::move(tmp.str_);
+        return *this;
+    }
+
+    number_suffix(std::string s)
+        : str_(s.empty() ? nullptr : new std::string(std::move(s)))
+    {}
+    number_suffix(const char* s): number_suffix(std::string(s)) {}
+
+    using value_type      = std::string::value_type;
+    using size_type       = std::string::size_type;
+    using reference       = std::string::reference;
+    using const_reference = std::string::const_reference;
+    using const_pointer   = std::string::const_pointer;
+    using const_iterator  = std::string::const_iterator;
+
+    // a non-const str() may leave an allocated empty string
+    bool        empty()  const noexcept {return ! this->str_ || this->str_->empty();}
+    std::size_t size()   const noexcept {return this->empty() ? 0 : this->str_->size();}
+    std::size_t length() const noexcept {return this->size();}
+
+    std::string const& str() const noexcept
+    {
+        static const std::string empty_str;
+        return this->empty() ? empty_str : *this->str_;
+    }
+    operator std::string const&() const noexcept {return this->str();}
+
+    // these allocate the string if it is empty, so that it can be modified
+    // through the reference.
+    std::string& str() {return this->get_or_allocate();}
+    operator std::string&() {return this->str();}
+
+    const_pointer c_str() const noexcept {return this->str().c_str();}
+    const_pointer data()  const noexcept {return this->str().data();}
+
+    const_reference operator[](const size_type i) const noexcept {return this->str()[i];}
+    const_reference at(const size_type i) const {return this->str().at(i);}
+    reference operator[](const size_type i) {return this->str()[i];}
+    reference at(const size_type i)         {return this->str().at(i);}
+
+    const_iterator begin()  const noexcept {return this->str().begin();}
+    const_iterator end()    const noexcept {return this->str().end();}
+    const_iterator cbegin() const noexcept {return this->str().cbegin();}
+    const_iterator cend()   const noexcept {return this->str().cend();}
+
+    std::string substr(const size_type pos = 0, const size_type n = std::string::npos) const
+    {
+        return this->str().substr(pos, n);
+    }
+
+    // modifiers allocate the string if it is empty.
+    number_suffix& append(const std::string& s)
+    {
+        if( ! s.empty())
+        {
+            this->get_or_allocate().append(s);
+        }
+        return *this;
+    }
+    number_suffix& append(const char* s) {return this->append(std::string(s));}
+    number_suffix& operator+=(const std::string& s) {return this->append(s);}
+    number_suffix& operator+=(const char* s)        {return this->append(s);}
+    number_suffix& operator+=(const char c)         {return this->append(std::string(1, c));}
+
+    number_suffix& insert(const size_type pos, const std::string& s)
+    {
+        this->get_or_allocate().insert(pos, s);
+        return *this;
+    }
+    number_suffix& insert(const size_type pos, const char* s)
+    {
+        return this->insert(pos, std::string(s));
+    }
+    number_suffix& insert(const size_type pos, const size_type n, const char c)
+    {
+        this->get_or_allocate().insert(pos, n, c);
+        return *this;
+    }
+    number_suffix& erase(const size_type pos = 0, const size_type n = std::string::npos)
+    {
+        this->get_or_allocate().erase(pos, n);
+        return *this;
+    }
+    void push_back(const char c) {this->get_or_allocate().push_back(c);}
+    void pop_back()              {this->get_or_allocate().pop_back();}
+    void resize(const size_type n)               {this->get_or_allocate().resize(n);}
+    void resize(const size_type n, const char c) {this->get_or_allocate().resize(n, c);}
+
+    void clear() noexcept {this->str_.reset();}
+
+  private:
+
+    std::string& get_or_allocate()
+    {
+        if( ! this->str_)
+        {
+            this->str_.reset(new std::string);
+        }
+        return *this->str_;
+    }
+
+    std::unique_ptr<std::string> str_; // nullptr if empty
+};
+
+bool operator==(const number_suffix&, const number_suffix&) noexcept;
+bool operator!=(const number_suffix&, const number_suffix&) noexcept;
+bool operator==(const number_suffix&, const std::string&) noexcept;
+bool operator!=(const number_suffix&, const std::string&) noexcept;
+bool operator==(const std::string&, const number_suffix&) noexcept;
+bool operator!=(const std::string&, const number_suffix&) noexcept;
+bool operator==(const number_suffix&, const char*) noexcept;
+bool operator!=(const number_suffix&, const char*) noexcept;
+
+std::ostream& operator<<(std::ostream& os, const number_suffix& s);
+
 // ----------------------------------------------------------------------------
 // integer
 
@@ -64,7 +202,7 @@ struct integer_format_info
     bool        uppercase = true; // hex with uppercase
     std::size_t width     = 0;    // minimal width (may exceed)
     std::size_t spacer    = 0;    // position of `_` (if 0, no spacer)
-    std::string suffix    = "";   // _suffix (library extension)
+    number_suffix suffix;         // _suffix (library extension)
 };
 
 bool operator==(const integer_format_info&, const integer_format_info&) noexcept;
@@ -88,7 +226,7 @@ struct floating_format_info
 {
     floating_format fmt = floating_format::defaultfloat;
     std::size_t prec  = 0;        // precision (if 0, use the default)
-    std::string suffix = "";      // 1.0e+2_suffix (library extension)
+    number_suffix suffix;         // 1.0e+2_suffix (library extension)
 };
 
 bool operator==(const floating_format_info&, const floating_format_info&) noexcept;
@@ -2,12 +2,17 @@
 #define TOML11_LOCATION_FWD_HPP
 
 #include "../result.hpp"
+#include "../source_buffer.hpp"
 #include "../version.hpp"
 
+#include <atomic>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include <cstddef>
+
 namespace toml
 {
 inline namespace TOML11_INLINE_VERSION_NAMESPACE
@@ -17,24 +22,143 @@ namespace detail
 
 class region; // fwd decl
 
+// the line and column numbers (1-origin) of the `offset`-th byte in `src`.
+std::size_t calc_line_number  (const source_buffer& src, const std::size_t offset) noexcept;
+std::size_t calc_column_number(const source_buffer& src, const std::size_t offset) noexcept;
+
+//
+// The source and its name. A location and all the regions made from it share
+// one, so that each of them does not have its own copy of the name.
+//
+struct source_info
+{
+    source_info(std::shared_ptr<const source_buffer> src, std::string src_name)
+        : source(std::move(src)), name(std::move(src_name)), refs(0)
+    {}
+
+    std::shared_ptr<const source_buffer> source;
+    std::string                          name;
+
+    mutable std::atomic<std::size_t> refs; // counted by source_info_ptr
+};
+
+//
+// A shared pointer to source_info. The reference count is in source_info, so
+// it is one pointer wide while std::shared_ptr is two. Every region has one.
+//
+class source_info_ptr
+{
+  public:
+
+    source_info_ptr() noexcept : ptr_(nullptr) {}
+    source_info_ptr(std::nullptr_t) noexcept : ptr_(nullptr) {}
+
+    // shares the ownership of `p` with the other source_info_ptrs.
+    explicit source_info_ptr(source_info const* p) noexcept : ptr_(p)
+    {
+        this->acquire();
+    }
+    ~source_info_ptr() noexcept {this->release();}
+
+    source_info_ptr(const source_info_ptr& other) noexcept : ptr_(other.ptr_)
+    {
+        this->acquire();
+    }
+    source_info_ptr(source_info_ptr&& other) noexcept : ptr_(other.ptr_)
+    {
+        other.ptr_ = nullptr;
+    }
+    source_info_ptr& operator=(const source_info_ptr& other) noexcept
+    {
+        source_info_ptr tmp(other);
+        this->swap(tmp);
+        return *this;
+    }
+    source_info_ptr& operator=(source_info_ptr&& other) noexcept
+    {
+        source_info_ptr tmp(std::move(other));
+        this->swap(tmp);
+        return *this;
+    }
+
+    void swap(source_info_ptr& other) noexcept {std::swap(this->ptr_, other.ptr_);}
+
+    source_info const* get()        const noexcept {return this->ptr_;}
+    source_info const& operator*()  const noexcept {return *this->ptr_;}
+    source_info const* operator->() const noexcept {return this->ptr_;}
+
+    explicit operator bool() const noexcept {return this->ptr_ != nullptr;}
+
+  private:
+
+    void acquire() noexcept
+    {
+        if(this->ptr_) {this->ptr_->refs.fetch_add(1, std::memory_order_relaxed);}
+    }
+    void release() noexcept
+    {
+        if(this->ptr_ && this->ptr_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            delete this->ptr_;
+        }
+    }
+
+  private:
+
+    source_info const* ptr_;
+};
+
+inline bool operator==(const source_info_ptr& lhs, const source_info_ptr& rhs) noexcept
+{
+    return lhs.get() == rhs.get();
+}
+inline bool operator!=(const source_info_ptr& lhs, const source_info_ptr& rhs) noexcept
+{
+    return !(lhs == rhs);
+}
+
+inline source_info_ptr make_source_info(std::shared_ptr<const source_buffer> src, std::string name)
+{
+    return source_info_ptr(new source_info(std::move(src), std::move(name)));
+}
+
+//
+// A position saved to go back there later, e.g. when an alternative does not
+// match. Unlike location, it does not refer to the source, so copying it does
+// not touch the reference count or copy the source name.
+//
+struct cursor
+{
+    std::size_t offset;
+};
+
 //
 // To represent where we are reading in the parse functions.
 // Since it "points" somewhere in the input stream, the length is always 1.
 //
+// It carries only the offset. The line and column numbers are computed from
+// the newline index of the source when they are requested, e.g. for an error
+// message, so advancing it does not look into the bytes it skips.
+//
 class location
 {
   public:
 
-    using char_type       = unsigned char; // must be unsigned
-    using container_type  = std::vector<char_type>;
+    using char_type       = source_buffer::char_type; // must be unsigned
+    using container_type  = source_buffer;
     using difference_type = typename container_type::difference_type; // to suppress sign-conversion warning
     using source_ptr      = std::shared_ptr<const container_type>;
 
   public:
 
     location(source_ptr src, std::string src_name)
-        : source_(std::move(src)), source_name_(std::move(src_name)),
-          location_(0), line_number_(1), column_number_(1)
+        : source_(std::move(src)),
+          info_(make_source_info(source_, std::move(src_name))),
+          location_(0)
+    {}
+    // the same source as `loc`, at `pos` that is taken from a location of it.
+    location(const location& loc, const cursor& pos)
+        : source_(loc.source_), info_(loc.info_), location_(pos.offset)
     {}
 
     location(const location&) = default;
@@ -46,6 +170,16 @@ class location
     void advance(std::size_t n = 1) noexcept;
     void retrace() noexcept;
 
+    cursor get_cursor() const noexcept
+    {
+        return cursor{this->location_};
+    }
+    // goes back (or forward) to `pos` that is taken from this location.
+    void reset(const cursor& pos) noexcept
+    {
+        this->location_ = pos.offset;
+    }
+
     bool is_ok() const noexcept { return static_cast<bool>(this->source_); }
 
     bool eof() const noexcept;
@@ -60,22 +194,16 @@ class location
 
     std::size_t line_number() const noexcept
     {
-        return this->line_number_;
+        return calc_line_number(*this->source_, this->location_);
     }
     std::size_t column_number() const noexcept
     {
-        return this->column_number_;
+        return calc_column_number(*this->source_, this->location_);
     }
     std::string get_line() const;
 
     source_ptr const&  source()      const noexcept {return this->source_;}
-    std::string const& source_name() const noexcept {return this->source_name_;}
-
-  private:
-
-    void advance_impl(const std::size_t n);
-    void retrace_impl();
-    std::size_t calc_column_number() const noexcept;
+    std::string const& source_name() const noexcept {return this->info_->name;}
 
   private:
 
@@ -83,11 +211,9 @@ class location
 
   private:
 
-    source_ptr  source_;
-    std::string source_name_;
+    source_ptr      source_; // the same as info_->source, to read it directly
+    source_info_ptr info_;
     std::size_t location_; // std::vector<>::difference_type is signed
-    std::size_t line_number_;
-    std::size_t column_number_;
 };
 
 bool operator==(const location& lhs, const location& rhs) noexcept;
@@ -4,10 +4,13 @@
 #include "../location.hpp"
 #include "../version.hpp"
 
+#include <algorithm>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include <cassert>
+#include <cstring>
 
 namespace toml
 {
@@ -16,10 +19,89 @@ inline namespace TOML11_INLINE_VERSION_NAMESPACE
 namespace detail
 {
 
+//
+// A non-owning view of the characters in a region, to read a token without
+// copying it into a std::string. It is valid while the source is alive.
+//
+class token_view
+{
+  public:
+
+    using const_iterator = char const*;
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+  public:
+
+    token_view() noexcept : first_(nullptr), size_(0) {}
+    token_view(char const* first, const std::size_t size) noexcept
+        : first_(first), size_(size)
+    {}
+
+    char const* data()  const noexcept {return this->first_;}
+    std::size_t size()  const noexcept {return this->size_;}
+    bool        empty() const noexcept {return this->size_ == 0;}
+
+    char operator[](const std::size_t i) const noexcept
+    {
+        assert(i < this->size_);
+        return this->first_[i];
+    }
+    char front() const noexcept {return (*this)[0];}
+    char back()  const noexcept {return (*this)[this->size_ - 1];}
+
+    const_iterator begin() const noexcept {return this->first_;}
+    const_iterator end()   const noexcept {return this->first_ + this->size_;}
+
+    // [pos, pos+n), capped by the size.
+    token_view substr(const std::size_t pos, const std::size_t n = npos) const noexcept
+    {
+        assert(pos <= this->size_);
+        return token_view(this->first_ + pos, (std::min)(n, this->size_ - pos));
+    }
+    // the position of the last `c`, or npos if not found.
+    std::size_t rfind(const char c) const noexcept
+    {
+        for(std::size_t i = this->size_; i != 0; --i)
+        {
+            if(this->first_[i - 1] == c) {return i - 1;}
+        }
+        return npos;
+    }
+
+    // copies the characters into a string whose character type is 1-byte.
+    template<typename String = std::string>
+    String as_string() const
+    {
+        static_assert(sizeof(typename String::value_type) == 1, "");
+        if(this->empty()) {return String();}
+        return String(reinterpret_cast<typename String::value_type const*>(
+                    this->first_), this->size_);
+    }
+
+  private:
+
+    char const* first_;
+    std::size_t size_;
+};
+
+inline bool operator==(const token_view& lhs, const char* rhs) noexcept
+{
+    return lhs.size() == std::strlen(rhs) &&
+           std::equal(lhs.begin(), lhs.end(), rhs);
+}
+inline bool operator!=(const token_view& lhs, const char* rhs) noexcept
+{
+    return !(lhs == rhs);
+}
+
 //
 // To represent where is a toml::value defined, or where does an error occur.
 // Stored in toml::value. source_location will be constructed based on this.
 //
+// It is kept small because every value has one. The source and its name are
+// shared via source_info, and the line and column numbers are computed from
+// the newline index of the source when they are requested.
+//
 class region
 {
   public:
@@ -35,15 +117,15 @@ class region
   public:
 
     // a value that is constructed manually does not have input stream info
-    region()
-        : source_(nullptr), source_name_(""), length_(0),
-          first_(0), first_line_(0), first_column_(0), last_(0), last_line_(0),
-          last_column_(0)
+    region() noexcept
+        : info_(nullptr), first_(0), length_(0)
     {}
 
     // a value defined in [first, last).
     // Those source must be the same. Instread, `region` does not make sense.
     region(const location& first, const location& last);
+    // the same as above, where `first` is saved from `last` by get_cursor().
+    region(const cursor& first, const location& last);
 
     // shorthand of [loc, loc+1)
     explicit region(const location& loc);
@@ -54,27 +136,37 @@ class region
     region& operator=(const region&) = default;
     region& operator=(region&&)      = default;
 
-    bool is_ok() const noexcept { return static_cast<bool>(this->source_); }
+    bool is_ok() const noexcept
+    {
+        return static_cast<bool>(this->info_) && static_cast<bool>(this->info_->source);
+    }
 
     operator bool() const noexcept { return this->is_ok(); }
 
-    std::size_t length() const noexcept {return this->length_;}
+    std::size_t length() const noexcept {return this->length_ & ~same_line_flag();}
 
+    // 0 if it does not have a source or the source is empty.
     std::size_t first_line_number() const noexcept
     {
-        return this->first_line_;
+        if( ! this->has_chars()) {return 0;}
+        return calc_line_number(*this->info_->source, this->first_);
     }
     std::size_t first_column_number() const noexcept
     {
-        return this->first_column_;
+        if( ! this->has_chars()) {return 0;}
+        return calc_column_number(*this->info_->source, this->first_);
     }
     std::size_t last_line_number() const noexcept
     {
-        return this->last_line_;
+        if( ! this->has_chars()) {return 0;}
+        return this->ends_at_newline() ? this->first_line_number() :
+            calc_line_number(*this->info_->source, this->last());
     }
     std::size_t last_column_number() const noexcept
     {
-        return this->last_column_;
+        if( ! this->has_chars()) {return 0;}
+        return this->ends_at_newline() ? this->first_column_number() + 1 :
+            calc_column_number(*this->info_->source, this->last());
     }
 
     char_type at(std::size_t i) const;
@@ -85,27 +177,140 @@ class region
     const_iterator cend() const noexcept;
 
     std::string as_string() const;
+    token_view  as_view() const noexcept
+    {
+        if( ! this->has_text()) {return token_view{};}
+        return token_view(reinterpret_cast<char const*>(
+            this->info_->source->data()) + this->first_, this->text_length());
+    }
     std::vector<std::pair<std::string, std::size_t>> as_lines() const;
 
-    source_ptr const&  source()      const noexcept {return this->source_;}
-    std::string const& source_name() const noexcept {return this->source_name_;}
+    source_ptr const&  source()      const noexcept;
+    std::string const& source_name() const noexcept;
 
   private:
 
     std::pair<std::string, std::size_t>
     take_line(const_iterator begin, const_iterator end) const;
 
+    std::size_t last() const noexcept {return this->first_ + this->length();}
+
+    // the number of chars in it. region(loc) at EOF points the column after
+    // the last char, so it can be shorter than length().
+    std::size_t text_length() const noexcept
+    {
+        if( ! this->is_ok()) {return 0;}
+        return (std::min)(this->length(), this->info_->source->size() - this->first_);
+    }
+
+    // an empty range if the source does not keep the text
+    const_iterator iter_at(const std::size_t offset) const noexcept;
+
+    bool has_chars() const noexcept
+    {
+        return this->is_ok() && ! this->info_->source->empty();
+    }
+    bool has_text() const noexcept
+    {
+        return this->is_ok() && this->info_->source->has_text();
+    }
+
+    // region(loc) pointing LF ends on the same line, unlike region(loc,
+    // next(loc)). It is marked by the MSB of length_, which a length never
+    // reaches.
+    static constexpr std::size_t same_line_flag() noexcept
+    {
+        return ~(~std::size_t(0) >> 1);
+    }
+    bool ends_at_newline() const noexcept
+    {
+        return (this->length_ & same_line_flag()) != 0;
+    }
+
   private:
 
-    source_ptr  source_;
-    std::string source_name_;
-    std::size_t length_;
+    friend class source_detacher;
+
+    source_info_ptr info_;
     std::size_t first_;
-    std::size_t first_line_;
-    std::size_t first_column_;
-    std::size_t last_;
-    std::size_t last_line_;
-    std::size_t last_column_;
+    std::size_t length_; // the MSB is same_line_flag
+};
+
+//
+// Moves regions onto copies of their sources that keep only the lines that
+// `as_lines` reads. The other lines are left empty, so the line and column
+// numbers and the lines shown in error messages do not change.
+//
+// If `keep_lines` is false, the copies keep only the offsets of the LFs. The
+// line and column numbers do not change, but `as_lines` returns empty lines.
+//
+// First `add` all the regions, then `detach` each of them. The original
+// sources are released when this and the original regions are destroyed.
+//
+class source_detacher
+{
+  public:
+
+    source_detacher() noexcept : keep_lines_(true) {}
+    explicit source_detacher(const bool keep_lines) noexcept
+        : keep_lines_(keep_lines)
+    {}
+
+    void   add   (const region& reg);
+    region detach(const region& reg);
+
+  private:
+
+    struct entry
+    {
+        source_info_ptr          original;
+        source_info_ptr          detached; // built on first detach
+        std::vector<bool>        keep;     // for each line
+        std::vector<std::size_t> offsets;  // line -> detached offset
+    };
+
+    entry* find_entry(const region& reg) noexcept;
+    void   build(entry& e) const;
+
+  private:
+
+    bool               keep_lines_;
+    std::vector<entry> entries_; // one for each source; usually just one
+};
+
+//
+// The region stored in a basic_value. If the type_config opts out of location
+// tracking (see `tracks_location` in value.hpp), it stores nothing and every
+// value looks like one that is constructed manually.
+//
+template<bool Track>
+class value_region;
+
+template<>
+class value_region<true>
+{
+  public:
+
+    value_region() = default;
+    value_region(region reg) noexcept: region_(std::move(reg)) {}
+    value_region(const value_region<false>&) noexcept: region_() {}
+
+    region const& get() const noexcept {return this->region_;}
+
+  private:
+    region region_;
+};
+
+template<>
+class value_region<false>
+{
+  public:
+
+    value_region() = default;
+    value_region(const region&) noexcept {}
+    value_region(const value_region<true>&) noexcept {}
+
+    region get() const noexcept {return region();}
 };
 
 } // namespace detail
@@ -0,0 +1,100 @@
+#ifndef TOML11_SIMD_FWD_HPP
+#define TOML11_SIMD_FWD_HPP
+
+#include "../version.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+// ----------------------------------------------------------------------------
+// Block-at-a-time searches over the input bytes.
+//
+// Each function below finds the first byte in [first, last) that has (or does
+// not have) some property and returns a pointer to it, or `last` if there is
+// no such byte. They test 32 (AVX2) or 16 (SSE2, NEON) bytes at once if
+// available, and fall back to a byte-by-byte loop otherwise and in the tail.
+//
+// The instruction set is chosen at compile time by the predefined macros of
+// the compiler (e.g. `-mavx2`). Define `TOML11_DISABLE_SIMD` to always use
+// the scalar loop. Define it in all the TUs or in none of them.
+//
+// In the header-only mode, every TU has its own inline definitions, compiled
+// for the instruction set of the TU. They are put in a namespace named after
+// the instruction set, so that TUs compiled with different flags do not share
+// one of them and run it on a CPU that does not support it. With
+// `TOML11_COMPILE_SOURCES`, they are defined once in the library, with the
+// instruction set that the library is compiled for.
+
+#if ! defined(TOML11_DISABLE_SIMD)
+#  if defined(__AVX2__)
+#    define TOML11_SIMD_AVX2
+#  elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define TOML11_SIMD_SSE2
+#  elif defined(__ARM_NEON) || defined(_M_ARM64)
+#    define TOML11_SIMD_NEON
+#  endif
+#endif
+
+#if defined(TOML11_COMPILE_SOURCES)
+#  define TOML11_SIMD_NAMESPACE simd_compiled
+#elif defined(TOML11_SIMD_AVX2)
+#  define TOML11_SIMD_NAMESPACE simd_avx2
+#elif defined(TOML11_SIMD_SSE2)
+#  define TOML11_SIMD_NAMESPACE simd_sse2
+#elif defined(TOML11_SIMD_NEON)
+#  define TOML11_SIMD_NAMESPACE simd_neon
+#else
+#  define TOML11_SIMD_NAMESPACE simd_scalar
+#endif
+
+namespace toml
+{
+inline namespace TOML11_INLINE_VERSION_NAMESPACE
+{
+namespace detail
+{
+inline namespace TOML11_SIMD_NAMESPACE
+{
+
+// the first byte that is neither ' ' nor '\t'.
+unsigned char const* find_first_not_wschar(
+        unsigned char const* first, unsigned char const* last) noexcept;
+
+// the first byte that is neither '\t' nor a printable ASCII [0x20, 0x7E].
+// Those are allowed in a comment under any version of TOML.
+unsigned char const* find_first_not_comment_ascii(
+        unsigned char const* first, unsigned char const* last) noexcept;
+
+// the first '\n'. Since CRLF also ends with LF, it is the end of a line.
+unsigned char const* find_newline(
+        unsigned char const* first, unsigned char const* last) noexcept;
+
+// the first byte that is '"', '\\', or a control character other than '\t',
+// i.e. one that a basic string cannot contain as-is. A byte >= 0x80 is taken
+// as a part of a valid UTF-8 character (see `validate_utf8` in parser.hpp).
+unsigned char const* find_basic_string_special(
+        unsigned char const* first, unsigned char const* last) noexcept;
+
+// the first byte that is not ASCII, i.e. >= 0x80.
+unsigned char const* find_first_non_ascii(
+        unsigned char const* first, unsigned char const* last) noexcept;
+
+// the first byte of the first invalid UTF-8 sequence, e.g. a stray
+// continuation byte, an overlong encoding, a surrogate, a codepoint larger
+// than U+10FFFF, or a sequence cut at `last`. With AVX2, 32 bytes including
+// multi-byte sequences are validated at once, and a block with an error is
+// checked again one by one to find the exact byte. Otherwise, runs of ASCII
+// are skipped by `find_first_non_ascii` and multi-byte sequences are checked
+// one by one.
+unsigned char const* find_invalid_utf8(
+        unsigned char const* first, unsigned char const* last) noexcept;
+
+} // TOML11_SIMD_NAMESPACE
+
+int count_trailing_zeros_32(std::uint32_t x) noexcept;
+int count_trailing_zeros_64(std::uint64_t x) noexcept;
+
+} // detail
+} // TOML11_INLINE_VERSION_NAMESPACE
+} // toml
+#endif // TOML11_SIMD_FWD_HPP
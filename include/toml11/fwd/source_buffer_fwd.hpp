@@ -0,0 +1,148 @@
+#ifndef TOML11_SOURCE_BUFFER_FWD_HPP
+#define TOML11_SOURCE_BUFFER_FWD_HPP
+
+#include "../result.hpp"
+#include "../version.hpp"
+
+#include <atomic>
+#include <istream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <cstddef>
+#include <cstdio>
+
+namespace toml
+{
+inline namespace TOML11_INLINE_VERSION_NAMESPACE
+{
+namespace detail
+{
+
+//
+// The whole input that is read by the parser.
+//
+// It either owns the content (copied into a std::vector), or refers to a
+// memory region that is owned by someone else, like a memory-mapped file.
+// In the latter case, `owner_` keeps the region alive until the last
+// location/region that refers to this buffer is destroyed.
+//
+// The offsets of LFs are collected on the first call that needs them, e.g.
+// `line_number`, and shared by all the locations and regions after that.
+// Building it is thread-safe; if two threads race, one of them is discarded.
+//
+class source_buffer
+{
+  public:
+
+    using char_type              = unsigned char; // must be unsigned
+    using value_type             = char_type;
+    using size_type              = std::size_t;
+    using difference_type        = std::ptrdiff_t;
+    using const_reference        = char_type const&;
+    using reference              = const_reference;
+    using const_iterator         = char_type const*;
+    using iterator               = const_iterator;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    using reverse_iterator       = const_reverse_iterator;
+    using storage_type           = std::vector<char_type>;
+
+  public:
+
+    explicit source_buffer(storage_type cont)
+        : storage_(std::move(cont)), owner_(nullptr),
+          data_(storage_.data()), size_(storage_.size()), newlines_(nullptr)
+    {}
+
+    // refers [data, data+size). `owner` must keep the region valid.
+    source_buffer(const char_type* data, const std::size_t size,
+                  std::shared_ptr<const void> owner)
+        : storage_(), owner_(std::move(owner)), data_(data), size_(size),
+          newlines_(nullptr)
+    {}
+
+    // keeps only the offsets of the LFs in a source of `size` chars. It has
+    // no text, so only the line and column numbers can be computed from it.
+    source_buffer(const std::size_t size, std::vector<std::size_t> newlines)
+        : storage_(), owner_(nullptr), data_(nullptr), size_(size),
+          newlines_(new std::vector<std::size_t>(std::move(newlines)))
+    {}
+
+    // data_ may point to storage_. it is always shared via shared_ptr.
+    source_buffer(const source_buffer&) = delete;
+    source_buffer(source_buffer&&)      = delete;
+    source_buffer& operator=(const source_buffer&) = delete;
+    source_buffer& operator=(source_buffer&&)      = delete;
+    ~source_buffer();
+
+    char_type const* data() const noexcept {return this->data_;}
+    std::size_t      size() const noexcept {return this->size_;}
+    bool            empty() const noexcept {return this->size_ == 0;}
+
+    // false if it keeps only the newlines. Do not read the chars then.
+    bool has_text() const noexcept
+    {
+        return this->data_ != nullptr || this->size_ == 0;
+    }
+
+    const_reference operator[](const std::size_t i) const noexcept
+    {
+        return this->data_[i];
+    }
+    const_reference at(const std::size_t i) const;
+
+    const_reference front() const noexcept {return this->data_[0];}
+    const_reference back()  const noexcept {return this->data_[this->size_ - 1];}
+
+    const_iterator begin()  const noexcept {return this->data_;}
+    const_iterator end()    const noexcept {return this->data_ + this->size_;}
+    const_iterator cbegin() const noexcept {return this->data_;}
+    const_iterator cend()   const noexcept {return this->data_ + this->size_;}
+
+    const_reverse_iterator rbegin()  const noexcept {return const_reverse_iterator(this->end());}
+    const_reverse_iterator rend()    const noexcept {return const_reverse_iterator(this->begin());}
+    const_reverse_iterator crbegin() const noexcept {return const_reverse_iterator(this->cend());}
+    const_reverse_iterator crend()   const noexcept {return const_reverse_iterator(this->cbegin());}
+
+    // offsets of all the LFs in ascending order.
+    std::vector<std::size_t> const& newlines() const;
+
+    // 1-origin line number of the character at `offset` (<= size()).
+    std::size_t line_number(const std::size_t offset) const;
+    // offset of the first character of the line that contains `offset`.
+    std::size_t line_begin(const std::size_t offset) const;
+    // offset of the LF at or after `offset`, or size() if there is none.
+    std::size_t line_end(const std::size_t offset) const;
+
+  private:
+
+    storage_type                storage_;
+    std::shared_ptr<const void> owner_;
+    char_type const*            data_;
+    std::size_t                 size_;
+
+    mutable std::atomic<std::vector<std::size_t> const*> newlines_;
+};
+
+// Maps a file into memory without copying it.
+//
+// Returns nullptr if the file cannot be mapped, e.g. it is not a regular file
+// (pipe, character device, ...), it is empty, or the platform does not
+// support memory mapping. In that case, the caller should fall back to read
+// the file into a buffer.
+std::shared_ptr<const source_buffer> map_file(const std::string& fname);
+
+// Reads the rest of the input in blocks, growing the buffer geometrically.
+//
+// It does not require the input to be seekable, so it works with pipes and
+// stdin. If the size is available, it is used only to reserve the buffer.
+// Returns an error if an I/O error occurs.
+result<source_buffer::storage_type, none_t> read_stream(std::istream& is);
+result<source_buffer::storage_type, none_t> read_file(std::FILE* fp);
+
+} // detail
+} // TOML11_INLINE_VERSION_NAMESPACE
+} // toml
+#endif // TOML11_SOURCE_BUFFER_FWD_HPP
@@ -305,6 +305,9 @@ either   const& string(const spec& s);
 // ===========================================================================
 // Keys
 
+// ALPHA / DIGIT / %x2D / %x5F and the non-ASCII ranges allowed in bare keys
+bool is_non_ascii_key_codepoint(const std::uint32_t cp) noexcept;
+
 // to keep `expected_chars` simple
 class non_ascii_key_char final : public scanner_base
 {
@@ -9,12 +9,12 @@ namespace toml
 inline namespace TOML11_INLINE_VERSION_NAMESPACE
 {
 
-TOML11_INLINE bool operator==(const preserve_comments& lhs, const preserve_comments& rhs) {return lhs.comments == rhs.comments;}
-TOML11_INLINE bool operator!=(const preserve_comments& lhs, const preserve_comments& rhs) {return lhs.comments != rhs.comments;}
-TOML11_INLINE bool operator< (const preserve_comments& lhs, const preserve_comments& rhs) {return lhs.comments <  rhs.comments;}
-TOML11_INLINE bool operator<=(const preserve_comments& lhs, const preserve_comments& rhs) {return lhs.comments <= rhs.comments;}
-TOML11_INLINE bool operator> (const preserve_comments& lhs, const preserve_comments& rhs) {return lhs.comments >  rhs.comments;}
-TOML11_INLINE bool operator>=(const preserve_comments& lhs, const preserve_comments& rhs) {return lhs.comments >= rhs.comments;}
+TOML11_INLINE bool operator==(const preserve_comments& lhs, const preserve_comments& rhs) {return lhs.get() == rhs.get();}
+TOML11_INLINE bool operator!=(const preserve_comments& lhs, const preserve_comments& rhs) {return lhs.get() != rhs.get();}
+TOML11_INLINE bool operator< (const preserve_comments& lhs, const preserve_comments& rhs) {return lhs.get() <  rhs.get();}
+TOML11_INLINE bool operator<=(const preserve_comments& lhs, const preserve_comments& rhs) {return lhs.get() <= rhs.get();}
+TOML11_INLINE bool operator> (const preserve_comments& lhs, const preserve_comments& rhs) {return lhs.get() >  rhs.get();}
+TOML11_INLINE bool operator>=(const preserve_comments& lhs, const preserve_comments& rhs) {return lhs.get() >= rhs.get();}
 
 TOML11_INLINE void swap(preserve_comments& lhs, preserve_comments& rhs)
 {
@@ -23,12 +23,12 @@ TOML11_INLINE void swap(preserve_comments& lhs, preserve_comments& rhs)
 }
 TOML11_INLINE void swap(preserve_comments& lhs, std::vector<std::string>& rhs)
 {
-    lhs.comments.swap(rhs);
+    lhs.get_or_allocate().swap(rhs);
     return;
 }
 TOML11_INLINE void swap(std::vector<std::string>& lhs, preserve_comments& rhs)
 {
-    lhs.swap(rhs.comments);
+    lhs.swap(rhs.get_or_allocate());
     return;
 }
 
@@ -39,6 +39,48 @@ TOML11_INLINE std::string to_string(const indent_char c)
 // ----------------------------------------------------------------------------
 // boolean
 
+// ----------------------------------------------------------------------------
+// number suffix
+
+TOML11_INLINE bool operator==(const number_suffix& lhs, const number_suffix& rhs) noexcept
+{
+    return lhs.str() == rhs.str();
+}
+TOML11_INLINE bool operator!=(const number_suffix& lhs, const number_suffix& rhs) noexcept
+{
+    return !(lhs == rhs);
+}
+TOML11_INLINE bool operator==(const number_suffix& lhs, const std::string& rhs) noexcept
+{
+    return lhs.str() == rhs;
+}
+TOML11_INLINE bool operator!=(const number_suffix& lhs, const std::string& rhs) noexcept
+{
+    return !(lhs == rhs);
+}
+TOML11_INLINE bool operator==(const std::string& lhs, const number_suffix& rhs) noexcept
+{
+    return lhs == rhs.str();
+}
+TOML11_INLINE bool operator!=(const std::string& lhs, const number_suffix& rhs) noexcept
+{
+    return !(lhs == rhs);
+}
+TOML11_INLINE bool operator==(const number_suffix& lhs, const char* rhs) noexcept
+{
+    return lhs.str() == rhs;
+}
+TOML11_INLINE bool operator!=(const number_suffix& lhs, const char* rhs) noexcept
+{
+    return !(lhs == rhs);
+}
+
+TOML11_INLINE std::ostream& operator<<(std::ostream& os, const number_suffix& s)
+{
+    os << s.str();
+    return os;
+}
+
 // ----------------------------------------------------------------------------
 // integer
 
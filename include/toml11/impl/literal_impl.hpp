@@ -16,6 +16,14 @@ namespace detail
 // implementation
 TOML11_INLINE ::toml::value literal_internal_impl(location loc)
 {
+    const auto utf8 = validate_utf8(loc);
+    if(utf8.is_err())
+    {
+        std::vector<error_info> errs{utf8.unwrap_err()};
+        auto msg = format_error(errs.front());
+        throw ::toml::syntax_error(std::move(msg), std::move(errs));
+    }
+
     const auto s = ::toml::spec::default_version();
     context<type_config> ctx(s);
 
@@ -74,7 +82,7 @@ TOML11_INLINE ::toml::value literal_internal_impl(location loc)
             auto com_res = parse_comment_line(loc, ctx);
             if(com_res.is_ok() && com_res.unwrap().has_value())
             {
-                val.comments().push_back(com_res.unwrap().value());
+                push_comment(val.comments(), com_res.unwrap().value());
             }
             return val;
         }
@@ -125,7 +133,7 @@ operator""_toml(const char* str, std::size_t len)
         return ::toml::value{};
     }
 
-    ::toml::detail::location::container_type c(len);
+    std::vector<::toml::detail::location::char_type> c(len);
     std::copy(reinterpret_cast<const ::toml::detail::location::char_type*>(str),
               reinterpret_cast<const ::toml::detail::location::char_type*>(str + len),
               c.begin());
@@ -156,7 +164,7 @@ operator"" _toml(const char8_t* str, std::size_t len)
         return ::toml::value{};
     }
 
-    ::toml::detail::location::container_type c(len);
+    std::vector<::toml::detail::location::char_type> c(len);
     std::copy(reinterpret_cast<const ::toml::detail::location::char_type*>(str),
               reinterpret_cast<const ::toml::detail::location::char_type*>(str + len),
               c.begin());
@@ -5,6 +5,8 @@
 #include "../utility.hpp"
 #include "../version.hpp"
 
+#include <algorithm>
+
 namespace toml
 {
 inline namespace TOML11_INLINE_VERSION_NAMESPACE
@@ -12,33 +14,27 @@ inline namespace TOML11_INLINE_VERSION_NAMESPACE
 namespace detail
 {
 
+TOML11_INLINE std::size_t
+calc_line_number(const source_buffer& src, const std::size_t offset) noexcept
+{
+    return src.line_number(offset);
+}
+
+TOML11_INLINE std::size_t
+calc_column_number(const source_buffer& src, const std::size_t offset) noexcept
+{
+    return offset - src.line_begin(offset) + 1;
+}
+
 TOML11_INLINE void location::advance(std::size_t n) noexcept
 {
     assert(this->is_ok());
-    if(this->location_ + n < this->source_->size())
-    {
-        this->advance_impl(n);
-    }
-    else
-    {
-        this->advance_impl(this->source_->size() - this->location_);
-
-        assert(this->location_ == this->source_->size());
-    }
+    this->location_ = (std::min)(this->location_ + n, this->source_->size());
 }
 TOML11_INLINE void location::retrace(/*restricted to n=1*/) noexcept
 {
     assert(this->is_ok());
-    if(this->location_ == 0)
-    {
-        this->location_ = 0;
-        this->line_number_ = 1;
-        this->column_number_ = 1;
-    }
-    else
-    {
-        this->retrace_impl();
-    }
+    this->location_ -= (this->location_ == 0) ? 0 : 1;
 }
 
 TOML11_INLINE bool location::eof() const noexcept
@@ -71,66 +67,10 @@ TOML11_INLINE location::char_type location::peek()
 TOML11_INLINE std::string location::get_line() const
 {
     assert(this->is_ok());
-    const auto iter = std::next(this->source_->cbegin(), static_cast<difference_type>(this->location_));
-    const auto riter = cxx::make_reverse_iterator(iter);
-
-    const auto prev = std::find(riter, this->source_->crend(), char_type('\n'));
-    const auto next = std::find(iter,  this->source_->cend(),  char_type('\n'));
-
-    return make_string(std::next(prev.base()), next);
-}
-
-TOML11_INLINE std::size_t location::calc_column_number() const noexcept
-{
-    assert(this->is_ok());
-    const auto iter  = std::next(this->source_->cbegin(), static_cast<difference_type>(this->location_));
-    const auto riter = cxx::make_reverse_iterator(iter);
-    const auto prev  = std::find(riter, this->source_->crend(), char_type('\n'));
-
-    assert(prev.base() <= iter);
-    return static_cast<std::size_t>(std::distance(prev.base(), iter) + 1); // 1-origin
-}
-
-TOML11_INLINE void location::advance_impl(const std::size_t n)
-{
-    assert(this->is_ok());
-    assert(this->location_ + n <= this->source_->size());
-
-    auto iter = this->source_->cbegin();
-    std::advance(iter, static_cast<difference_type>(this->location_));
-
-    for(std::size_t i=0; i<n; ++i)
-    {
-        const auto c = *iter;
-        if(c == char_type('\n'))
-        {
-            this->line_number_  += 1;
-            this->column_number_ = 1;
-        }
-        else
-        {
-            this->column_number_ += 1;
-        }
-        iter++;
-    }
-    this->location_ += n;
-    return;
-}
-TOML11_INLINE void location::retrace_impl(/*n == 1*/)
-{
-    assert(this->is_ok());
-    assert(this->location_ != 0);
-
-    this->location_ -= 1;
-
-    auto iter = this->source_->cbegin();
-    std::advance(iter, static_cast<difference_type>(this->location_));
-    if(*iter == '\n')
-    {
-        this->line_number_ -= 1;
-        this->column_number_ = this->calc_column_number();
-    }
-    return;
+    const auto first = this->source_->line_begin(this->location_);
+    const auto last  = this->source_->line_end  (this->location_);
+    return make_string(std::next(this->source_->cbegin(), static_cast<difference_type>(first)),
+                       std::next(this->source_->cbegin(), static_cast<difference_type>(last)));
 }
 
 TOML11_INLINE bool operator==(const location& lhs, const location& rhs) noexcept
@@ -163,7 +103,7 @@ TOML11_INLINE location next(const location& loc)
 
 TOML11_INLINE location make_temporary_location(const std::string& str) noexcept
 {
-    location::container_type cont(str.size());
+    std::vector<location::char_type> cont(str.size());
     std::transform(str.begin(), str.end(), cont.begin(),
         [](const std::string::value_type& c) {
             return cxx::bit_cast<location::char_type>(c);
@@ -22,134 +22,148 @@ namespace detail
 // a value defined in [first, last).
 // Those source must be the same. Instread, `region` does not make sense.
 TOML11_INLINE region::region(const location& first, const location& last)
-    : source_(first.source()), source_name_(first.source_name()),
-      length_(last.get_location() - first.get_location()),
-      first_(first.get_location()),
-      first_line_(first.line_number()),
-      first_column_(first.column_number()),
-      last_(last.get_location()),
-      last_line_(last.line_number()),
-      last_column_(last.column_number())
+    : info_(first.info_), first_(first.get_location()),
+      length_(last.get_location() - first.get_location())
 {
     assert(first.source()      == last.source());
     assert(first.source_name() == last.source_name());
 }
 
-    // shorthand of [loc, loc+1)
+TOML11_INLINE region::region(const cursor& first, const location& last)
+    : info_(last.info_), first_(first.offset),
+      length_(last.get_location() - first.offset)
+{
+    assert(first.offset <= last.get_location());
+}
+
+// shorthand of [loc, loc+1)
 TOML11_INLINE region::region(const location& loc)
-    : source_(loc.source()), source_name_(loc.source_name()), length_(0),
-      first_line_(0), first_column_(0), last_line_(0), last_column_(0)
+    : info_(loc.info_), first_(0), length_(0)
 {
     // if the file ends with LF, the resulting region points no char.
     if(loc.eof())
     {
-        if(loc.get_location() == 0)
+        const auto& src = *loc.source();
+        if(src.empty())
+        {
+            // nothing to point
+        }
+        else if(src.back() == '\n')
         {
-            this->length_       = 0;
-            this->first_        = 0;
-            this->first_line_   = 0;
-            this->first_column_ = 0;
-            this->last_         = 0;
-            this->last_line_    = 0;
-            this->last_column_  = 0;
+            // [prev(loc), loc). It ends on the next line because it points LF.
+            this->first_  = loc.get_location() - 1;
+            this->length_ = 1;
         }
         else
         {
-            const auto first = prev(loc);
-            this->first_        = first.get_location();
-            this->first_line_   = first.line_number();
-            this->first_column_ = first.column_number();
-            this->last_         = loc.get_location();
-            this->last_line_    = loc.line_number();
-            this->last_column_  = loc.column_number();
-            this->length_       = 1;
+            // the column just after the last char. It has no char in it.
+            this->first_  = loc.get_location();
+            this->length_ = 1 | same_line_flag();
         }
     }
     else
     {
-        this->first_        = loc.get_location();
-        this->first_line_   = loc.line_number();
-        this->first_column_ = loc.column_number();
-        this->last_         = loc.get_location() + 1;
-        this->last_line_    = loc.line_number();
-        this->last_column_  = loc.column_number() + 1;
-        this->length_       = 1;
+        this->first_  = loc.get_location();
+        this->length_ = 1;
+
+        // Unlike region(loc, next(loc)), it ends on the same line even if it
+        // points LF.
+        if(loc.current() == '\n')
+        {
+            this->length_ |= same_line_flag();
+        }
     }
 }
 
+TOML11_INLINE region::source_ptr const& region::source() const noexcept
+{
+    static const source_ptr null_source;
+    return this->info_ ? this->info_->source : null_source;
+}
+TOML11_INLINE std::string const& region::source_name() const noexcept
+{
+    static const std::string null_name;
+    return this->info_ ? this->info_->name : null_name;
+}
+
 TOML11_INLINE region::char_type region::at(std::size_t i) const
 {
-    if(this->last_ <= this->first_ + i)
+    if(this->text_length() <= i)
     {
         throw std::out_of_range("range::at: index " + std::to_string(i) +
-                " exceeds length " + std::to_string(this->length_));
+                " exceeds length " + std::to_string(this->text_length()));
     }
-    const auto iter = std::next(this->source_->cbegin(),
-            static_cast<difference_type>(this->first_ + i));
-    return *iter;
+    if( ! this->has_text())
+    {
+        throw std::out_of_range("range::at: the text of the source is not kept");
+    }
+    return *this->iter_at(this->first_ + i);
+}
+
+TOML11_INLINE region::const_iterator
+region::iter_at(const std::size_t offset) const noexcept
+{
+    if( ! this->has_text()) {return const_iterator{};}
+    return std::next(this->info_->source->cbegin(),
+            static_cast<difference_type>(offset));
 }
 
 TOML11_INLINE region::const_iterator region::begin() const noexcept
 {
-    return std::next(this->source_->cbegin(),
-            static_cast<difference_type>(this->first_));
+    return this->iter_at(this->first_);
 }
 TOML11_INLINE region::const_iterator region::end() const noexcept
 {
-    return std::next(this->source_->cbegin(),
-            static_cast<difference_type>(this->last_));
+    return this->iter_at(this->first_ + this->text_length());
 }
 TOML11_INLINE region::const_iterator region::cbegin() const noexcept
 {
-    return std::next(this->source_->cbegin(),
-            static_cast<difference_type>(this->first_));
+    return this->iter_at(this->first_);
 }
 TOML11_INLINE region::const_iterator region::cend() const noexcept
 {
-    return std::next(this->source_->cbegin(),
-            static_cast<difference_type>(this->last_));
+    return this->iter_at(this->first_ + this->text_length());
 }
 
 TOML11_INLINE std::string region::as_string() const
 {
-    if(this->is_ok())
-    {
-        const auto begin = std::next(this->source_->cbegin(), static_cast<difference_type>(this->first_));
-        const auto end   = std::next(this->source_->cbegin(), static_cast<difference_type>(this->last_ ));
-        return ::toml::detail::make_string(begin, end);
-    }
-    else
-    {
-        return std::string("");
-    }
+    return this->as_view().as_string();
 }
 
 TOML11_INLINE std::pair<std::string, std::size_t>
 region::take_line(const_iterator begin, const_iterator end) const
 {
+    const auto& src = *this->info_->source;
+
     // To omit long line, we cap region by before/after 30 chars
-    const auto dist_before = std::distance(source_->cbegin(), begin);
-    const auto dist_after  = std::distance(end, source_->cend());
+    const auto dist_before = std::distance(src.cbegin(), begin);
+    const auto dist_after  = std::distance(end, src.cend());
+
+    const const_iterator capped_begin = (dist_before <= 30) ? src.cbegin() : std::prev(begin, 30);
+    const const_iterator capped_end   = (dist_after  <= 30) ? src.cend()   : std::next(end,   30);
 
-    const const_iterator capped_begin = (dist_before <= 30) ? source_->cbegin() : std::prev(begin, 30);
-    const const_iterator capped_end   = (dist_after  <= 30) ? source_->cend()   : std::next(end,   30);
+    // look up the LFs around the region in the index of the source
+    const auto line_begin = std::next(src.cbegin(), static_cast<difference_type>(
+            src.line_begin(static_cast<std::size_t>(dist_before))));
+    const auto line_end   = std::next(src.cbegin(), static_cast<difference_type>(
+            src.line_end(src.size() - static_cast<std::size_t>(dist_after))));
 
-    const auto lf = char_type('\n');
-    const auto lf_before = std::find(cxx::make_reverse_iterator(begin),
-                                     cxx::make_reverse_iterator(capped_begin), lf);
-    const auto lf_after  = std::find(end, capped_end, lf);
+    const bool omit_before = line_begin < capped_begin;
+    const bool omit_after  = capped_end < line_end;
+    const auto first = omit_before ? capped_begin : line_begin;
+    const auto last  = omit_after  ? capped_end   : line_end;
 
-    auto offset = static_cast<std::size_t>(std::distance(lf_before.base(), begin));
+    auto offset = static_cast<std::size_t>(std::distance(first, begin));
 
-    std::string retval = make_string(lf_before.base(), lf_after);
+    std::string retval = make_string(first, last);
 
-    if(lf_before.base() != source_->cbegin() && *lf_before != lf)
+    if(omit_before)
     {
         retval = "... " + retval;
         offset += 4;
     }
 
-    if(lf_after != source_->cend() && *lf_after != lf)
+    if(omit_after)
     {
         retval = retval + " ...";
     }
@@ -160,12 +174,19 @@ region::take_line(const_iterator begin, const_iterator end) const
 TOML11_INLINE std::vector<std::pair<std::string, std::size_t>> region::as_lines() const
 {
     assert(this->is_ok());
-    if(this->length_ == 0)
+    if(this->length() == 0)
     {
         return std::vector<std::pair<std::string, std::size_t>>{
             std::make_pair("", std::size_t(0))
         };
     }
+    if( ! this->has_text())
+    {
+        // only the position is known. point it in an empty line.
+        return std::vector<std::pair<std::string, std::size_t>>{
+            std::make_pair("", this->first_column_number() - 1)
+        };
+    }
 
     // Consider the following toml file
     // ```
@@ -194,14 +215,16 @@ TOML11_INLINE std::vector<std::pair<std::string, std::size_t>> region::as_lines(
     // ```
     // So we start from `end-1` when looking for LF.
 
+    const auto& src = *this->info_->source;
+
     const auto begin_idx = static_cast<difference_type>(this->first_);
-    const auto end_idx   = static_cast<difference_type>(this->last_) - 1;
+    const auto end_idx   = static_cast<difference_type>(this->last()) - 1;
 
-    // length_ != 0, so begin < end. then begin <= end-1
+    // length() != 0, so begin < end. then begin <= end-1
     assert(begin_idx <= end_idx);
 
-    const auto begin = std::next(this->source_->cbegin(), begin_idx);
-    const auto end   = std::next(this->source_->cbegin(), end_idx);
+    const auto begin = std::next(src.cbegin(), begin_idx);
+    const auto end   = std::next(src.cbegin(), end_idx);
 
     assert(this->first_line_number() <= this->last_line_number());
 
@@ -215,17 +238,21 @@ TOML11_INLINE std::vector<std::pair<std::string, std::size_t>> region::as_lines(
     // we have multiple lines. `begin` and `end` points different lines.
     // that means that there is at least one `LF` between `begin` and `end`.
 
-    const auto after_begin = std::distance(begin, this->source_->cend());
-    const auto before_end  = std::distance(this->source_->cbegin(), end);
+    const auto after_begin = std::distance(begin, src.cend());
+    const auto before_end  = std::distance(src.cbegin(), end);
 
-    const_iterator capped_file_end   = this->source_->cend();
-    const_iterator capped_file_begin = this->source_->cbegin();
+    const_iterator capped_file_end   = src.cend();
+    const_iterator capped_file_begin = src.cbegin();
     if(60 < after_begin) {capped_file_end   = std::next(begin, 50);}
     if(60 < before_end)  {capped_file_begin = std::prev(end,   50);}
 
-    const auto lf = char_type('\n');
-    const auto first_line_end  = std::find(begin, capped_file_end, lf);
-    const auto last_line_begin = std::find(capped_file_begin, end, lf);
+    const auto to_iter = [&src](const std::size_t i) {
+        return std::next(src.cbegin(), static_cast<difference_type>(i));
+    };
+    const auto first_line_end  = (std::min)(capped_file_end, to_iter(
+            src.line_end(this->first_)));
+    const auto last_line_begin = (std::min)(end, to_iter(src.line_end(
+            static_cast<std::size_t>(std::distance(src.cbegin(), capped_file_begin)))));
 
     const auto first_line = this->take_line(begin, first_line_end);
     const auto last_line  = this->take_line(last_line_begin, end);
@@ -244,6 +271,123 @@ TOML11_INLINE std::vector<std::pair<std::string, std::size_t>> region::as_lines(
     }
 }
 
+TOML11_INLINE source_detacher::entry*
+source_detacher::find_entry(const region& reg) noexcept
+{
+    for(auto& e : this->entries_)
+    {
+        if(e.original == reg.info_) {return std::addressof(e);}
+    }
+    return nullptr;
+}
+
+TOML11_INLINE void source_detacher::add(const region& reg)
+{
+    // nothing to release if it does not keep the text
+    if( ! reg.has_chars() || ! reg.has_text()) {return;}
+    const auto& src = *reg.info_->source;
+
+    entry* e = this->find_entry(reg);
+    if( ! e)
+    {
+        entry newe;
+        newe.original = reg.info_;
+        newe.keep.resize(src.newlines().size() + 1, false);
+        this->entries_.push_back(std::move(newe));
+        e = std::addressof(this->entries_.back());
+    }
+    assert( ! e->detached); // all the regions should be added before detaching
+
+    if( ! this->keep_lines_) {return;} // all the lines are dropped
+
+    // the lines as_lines() reads. For a region over multiple lines, it also
+    // looks at up to 60 chars around the both ends.
+    std::size_t first = reg.first_;
+    std::size_t last  = reg.first_;
+    if(reg.length() != 0 && reg.first_line_number() != reg.last_line_number())
+    {
+        const std::size_t end_idx = reg.last() - 1;
+        first = (60 < end_idx) ? (std::min)(first, end_idx - 61) : 0;
+        last  = (60 < src.size() - reg.first_) ?
+                (std::max)(end_idx, reg.first_ + 60) : src.size();
+    }
+    for(std::size_t i = src.line_number(first); i <= src.line_number(last); ++i)
+    {
+        e->keep.at(i - 1) = true;
+    }
+    return;
+}
+
+TOML11_INLINE void source_detacher::build(entry& e) const
+{
+    const auto& src = *e.original->source;
+    const auto& nls = src.newlines();
+
+    if( ! this->keep_lines_)
+    {
+        // the offsets do not change, so no need to translate regions
+        e.detached = make_source_info(std::make_shared<const source_buffer>(
+            src.size(), nls), e.original->name);
+        return;
+    }
+
+    source_buffer::storage_type buf;
+    e.offsets.resize(e.keep.size());
+
+    std::size_t line_first = 0;
+    for(std::size_t i = 0; i < e.keep.size(); ++i)
+    {
+        const std::size_t line_last = (i < nls.size()) ? nls.at(i) : src.size();
+        e.offsets.at(i) = buf.size();
+        if(e.keep.at(i))
+        {
+            buf.insert(buf.end(),
+                std::next(src.cbegin(), static_cast<region::difference_type>(line_first)),
+                std::next(src.cbegin(), static_cast<region::difference_type>(line_last)));
+        }
+        if(i < nls.size())
+        {
+            buf.push_back('\n');
+        }
+        line_first = line_last + 1;
+    }
+    buf.shrink_to_fit();
+
+    e.detached = make_source_info(
+        std::make_shared<const source_buffer>(std::move(buf)), e.original->name);
+    return;
+}
+
+TOML11_INLINE region source_detacher::detach(const region& reg)
+{
+    entry* e = reg.has_chars() ? this->find_entry(reg) : nullptr;
+    if( ! e) {return reg;} // manually constructed, or not added
+
+    if( ! e->detached)
+    {
+        this->build(*e);
+    }
+    if( ! this->keep_lines_)
+    {
+        region retval(reg);
+        retval.info_ = e->detached;
+        return retval;
+    }
+
+    // a line is at the same column in the detached source
+    const auto& src = *reg.info_->source;
+    const auto translate = [&src, e](const std::size_t off) -> std::size_t {
+        return e->offsets.at(src.line_number(off) - 1) + (off - src.line_begin(off));
+    };
+
+    region retval;
+    retval.info_   = e->detached;
+    retval.first_  = translate(reg.first_);
+    retval.length_ = reg.ends_at_newline() ? reg.length_ :
+                     translate(reg.last()) - retval.first_;
+    return retval;
+}
+
 } // namespace detail
 } // TOML11_INLINE_VERSION_NAMESPACE
 } // namespace toml
@@ -0,0 +1,526 @@
+#ifndef TOML11_SIMD_IMPL_HPP
+#define TOML11_SIMD_IMPL_HPP
+
+#include "../fwd/simd_fwd.hpp"
+#include "../version.hpp"
+
+#include <cstring>
+
+#if defined(TOML11_SIMD_AVX2)
+#include <immintrin.h>
+#elif defined(TOML11_SIMD_SSE2)
+#include <emmintrin.h>
+#elif defined(TOML11_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
+#if defined(_MSC_VER) && ! defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace toml
+{
+inline namespace TOML11_INLINE_VERSION_NAMESPACE
+{
+namespace detail
+{
+
+TOML11_INLINE int count_trailing_zeros_32(std::uint32_t x) noexcept
+{
+    // x != 0
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(x);
+#elif defined(_MSC_VER)
+    unsigned long n = 0;
+    _BitScanForward(&n, x);
+    return static_cast<int>(n);
+#else
+    int n = 0;
+    while((x & 1u) == 0)
+    {
+        x >>= 1;
+        ++n;
+    }
+    return n;
+#endif
+}
+
+TOML11_INLINE int count_trailing_zeros_64(std::uint64_t x) noexcept
+{
+    // x != 0
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(x);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+    unsigned long n = 0;
+    _BitScanForward64(&n, x);
+    return static_cast<int>(n);
+#else
+    const auto lo = static_cast<std::uint32_t>(x);
+    return lo != 0 ? count_trailing_zeros_32(lo) :
+        32 + count_trailing_zeros_32(static_cast<std::uint32_t>(x >> 32));
+#endif
+}
+
+inline namespace TOML11_SIMD_NAMESPACE
+{
+
+#if defined(TOML11_SIMD_NEON)
+// NEON does not have movemask. Narrowing 16 bytes of 0x00/0xFF to 4 bits
+// each gives a 64-bit mask where byte i corresponds to bits [4i, 4i+4).
+TOML11_INLINE std::uint64_t neon_nibble_mask(const uint8x16_t m) noexcept
+{
+    const uint8x8_t n = vshrn_n_u16(vreinterpretq_u16_u8(m), 4);
+    return vget_lane_u64(vreinterpret_u64_u8(n), 0);
+}
+#endif
+
+TOML11_INLINE unsigned char const* find_first_not_wschar(
+        unsigned char const* first, unsigned char const* last) noexcept
+{
+#if defined(TOML11_SIMD_AVX2)
+    const __m256i space = _mm256_set1_epi8(' ');
+    const __m256i tab   = _mm256_set1_epi8('\t');
+    for(; last - first >= 32; first += 32)
+    {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+        const __m256i is_ws = _mm256_or_si256(
+            _mm256_cmpeq_epi8(v, space), _mm256_cmpeq_epi8(v, tab));
+        const auto mask = ~static_cast<std::uint32_t>(_mm256_movemask_epi8(is_ws));
+        if(mask != 0)
+        {
+            return first + count_trailing_zeros_32(mask);
+        }
+    }
+#elif defined(TOML11_SIMD_SSE2)
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i tab   = _mm_set1_epi8('\t');
+    for(; last - first >= 16; first += 16)
+    {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+        const __m128i is_ws = _mm_or_si128(
+            _mm_cmpeq_epi8(v, space), _mm_cmpeq_epi8(v, tab));
+        const auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(is_ws)) ^ 0xFFFFu;
+        if(mask != 0)
+        {
+            return first + count_trailing_zeros_32(mask);
+        }
+    }
+#elif defined(TOML11_SIMD_NEON)
+    const uint8x16_t space = vdupq_n_u8(' ');
+    const uint8x16_t tab   = vdupq_n_u8('\t');
+    for(; last - first >= 16; first += 16)
+    {
+        const uint8x16_t v = vld1q_u8(first);
+        const uint8x16_t is_ws = vorrq_u8(vceqq_u8(v, space), vceqq_u8(v, tab));
+        const auto mask = ~neon_nibble_mask(is_ws);
+        if(mask != 0)
+        {
+            return first + count_trailing_zeros_64(mask) / 4;
+        }
+    }
+#endif
+    while(first != last && (*first == ' ' || *first == '\t'))
+    {
+        ++first;
+    }
+    return first;
+}
+
+TOML11_INLINE unsigned char const* find_first_not_comment_ascii(
+        unsigned char const* first, unsigned char const* last) noexcept
+{
+    // signed comparison: bytes >= 0x80 (non-ASCII) are negative and fail
+    // the `> 0x1F` test.
+#if defined(TOML11_SIMD_AVX2)
+    const __m256i lower = _mm256_set1_epi8(0x1F);
+    const __m256i upper = _mm256_set1_epi8(0x7F);
+    const __m256i tab   = _mm256_set1_epi8('\t');
+    for(; last - first >= 32; first += 32)
+    {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+        const __m256i ok = _mm256_or_si256(
+            _mm256_and_si256(_mm256_cmpgt_epi8(v, lower), _mm256_cmpgt_epi8(upper, v)),
+            _mm256_cmpeq_epi8(v, tab));
+        const auto mask = ~static_cast<std::uint32_t>(_mm256_movemask_epi8(ok));
+        if(mask != 0)
+        {
+            return first + count_trailing_zeros_32(mask);
+        }
+    }
+#elif defined(TOML11_SIMD_SSE2)
+    const __m128i lower = _mm_set1_epi8(0x1F);
+    const __m128i upper = _mm_set1_epi8(0x7F);
+    const __m128i tab   = _mm_set1_epi8('\t');
+    for(; last - first >= 16; first += 16)
+    {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+        const __m128i ok = _mm_or_si128(
+            _mm_and_si128(_mm_cmpgt_epi8(v, lower), _mm_cmplt_epi8(v, upper)),
+            _mm_cmpeq_epi8(v, tab));
+        const auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(ok)) ^ 0xFFFFu;
+        if(mask != 0)
+        {
+            return first + count_trailing_zeros_32(mask);
+        }
+    }
+#elif defined(TOML11_SIMD_NEON)
+    const uint8x16_t lower = vdupq_n_u8(0x20);
+    const uint8x16_t upper = vdupq_n_u8(0x7E);
+    const uint8x16_t tab   = vdupq_n_u8('\t');
+    for(; last - first >= 16; first += 16)
+    {
+        const uint8x16_t v = vld1q_u8(first);
+        const uint8x16_t ok = vorrq_u8(
+            vandq_u8(vcgeq_u8(v, lower), vcleq_u8(v, upper)), vceqq_u8(v, tab));
+        const auto mask = ~neon_nibble_mask(ok);
+        if(mask != 0)
+        {
+            return first + count_trailing_zeros_64(mask) / 4;
+        }
+    }
+#endif
+    while(first != last && ((0x20 <= *first && *first <= 0x7E) || *first == '\t'))
+    {
+        ++first;
+    }
+    return first;
+}
+
+TOML11_INLINE unsigned char const* find_newline(
+        unsigned char const* first, unsigned char const* last) noexcept
+{
+    // memchr is already vectorized by the standard library.
+    if(first == last)
+    {
+        return last;
+    }
+    const auto found = std::memchr(first, '\n', static_cast<std::size_t>(last - first));
+    return found ? static_cast<unsigned char const*>(found) : last;
+}
+
+TOML11_INLINE unsigned char const* find_basic_string_special(
+        unsigned char const* first, unsigned char const* last) noexcept
+{
+    // `min(v, 0x1F) == v` is an unsigned `v < 0x20`.
+#if defined(TOML11_SIMD_AVX2)
+    const __m256i ctrl = _mm256_set1_epi8(0x1F);
+    const __m256i del  = _mm256_set1_epi8(0x7F);
+    const __m256i tab  = _mm256_set1_epi8('\t');
+    const __m256i dq   = _mm256_set1_epi8('"');
+    const __m256i bs   = _mm256_set1_epi8('\\');
+    for(; last - first >= 32; first += 32)
+    {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+        const __m256i is_ctrl = _mm256_andnot_si256(_mm256_cmpeq_epi8(v, tab),
+            _mm256_cmpeq_epi8(_mm256_min_epu8(v, ctrl), v));
+        const __m256i m = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, dq), _mm256_cmpeq_epi8(v, bs)),
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, del), is_ctrl));
+        const auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(m));
+        if(mask != 0)
+        {
+            return first + count_trailing_zeros_32(mask);
+        }
+    }
+#elif defined(TOML11_SIMD_SSE2)
+    const __m128i ctrl = _mm_set1_epi8(0x1F);
+    const __m128i del  = _mm_set1_epi8(0x7F);
+    const __m128i tab  = _mm_set1_epi8('\t');
+    const __m128i dq   = _mm_set1_epi8('"');
+    const __m128i bs   = _mm_set1_epi8('\\');
+    for(; last - first >= 16; first += 16)
+    {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+        const __m128i is_ctrl = _mm_andnot_si128(_mm_cmpeq_epi8(v, tab),
+            _mm_cmpeq_epi8(_mm_min_epu8(v, ctrl), v));
+        const __m128i m = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(v, dq), _mm_cmpeq_epi8(v, bs)),
+            _mm_or_si128(_mm_cmpeq_epi8(v, del), is_ctrl));
+        const auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(m));
+        if(mask != 0)
+        {
+            return first + count_trailing_zeros_32(mask);
+        }
+    }
+#elif defined(TOML11_SIMD_NEON)
+    const uint8x16_t ctrl = vdupq_n_u8(0x20);
+    const uint8x16_t del  = vdupq_n_u8(0x7F);
+    const uint8x16_t tab  = vdupq_n_u8('\t');
+    const uint8x16_t dq   = vdupq_n_u8('"');
+    const uint8x16_t bs   = vdupq_n_u8('\\');
+    for(; last - first >= 16; first += 16)
+    {
+        const uint8x16_t v = vld1q_u8(first);
+        const uint8x16_t is_ctrl = vbicq_u8(vcltq_u8(v, ctrl), vceqq_u8(v, tab));
+        const uint8x16_t m = vorrq_u8(
+            vorrq_u8(vceqq_u8(v, dq), vceqq_u8(v, bs)),
+            vorrq_u8(vceqq_u8(v, del), is_ctrl));
+        const auto mask = neon_nibble_mask(m);
+        if(mask != 0)
+        {
+            return first + count_trailing_zeros_64(mask) / 4;
+        }
+    }
+#endif
+    while(first != last && *first != '"' && *first != '\\' && *first != 0x7F &&
+          (0x20 <= *first || *first == '\t'))
+    {
+        ++first;
+    }
+    return first;
+}
+
+TOML11_INLINE unsigned char const* find_first_non_ascii(
+        unsigned char const* first, unsigned char const* last) noexcept
+{
+#if defined(TOML11_SIMD_AVX2)
+    for(; last - first >= 32; first += 32)
+    {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+        const auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(v));
+        if(mask != 0)
+        {
+            return first + count_trailing_zeros_32(mask);
+        }
+    }
+#elif defined(TOML11_SIMD_SSE2)
+    for(; last - first >= 16; first += 16)
+    {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+        const auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(v));
+        if(mask != 0)
+        {
+            return first + count_trailing_zeros_32(mask);
+        }
+    }
+#elif defined(TOML11_SIMD_NEON)
+    const uint8x16_t upper = vdupq_n_u8(0x7F);
+    for(; last - first >= 16; first += 16)
+    {
+        const uint8x16_t v = vld1q_u8(first);
+        const auto mask = neon_nibble_mask(vcgtq_u8(v, upper));
+        if(mask != 0)
+        {
+            return first + count_trailing_zeros_64(mask) / 4;
+        }
+    }
+#endif
+    while(first != last && *first < 0x80)
+    {
+        ++first;
+    }
+    return first;
+}
+
+#if defined(TOML11_SIMD_AVX2)
+// Validates 32 bytes at a time with the lookup algorithm of Keiser and Lemire,
+// "Validating UTF-8 In Less Than One Instruction Per Byte" (2021). Each pair
+// of adjacent bytes is classified by three table lookups, the high and low
+// nibbles of the first byte and the high nibble of the second, and a bit set
+// in all three is an error. A continuation byte is expected only where the
+// byte 2 or 3 before is a 3 or 4-byte leading byte (the TWO_CONTS bit).
+//
+// It returns the start of the first character that is not in a block known
+// to be valid, from which the scalar loop continues and finds the exact byte.
+TOML11_INLINE unsigned char const* skip_valid_utf8_avx2(
+        unsigned char const* first, unsigned char const* last) noexcept
+{
+    constexpr unsigned char TOO_SHORT      = 1u << 0; // 11______ 0_______
+    constexpr unsigned char TOO_LONG       = 1u << 1; // 0_______ 10______
+    constexpr unsigned char OVERLONG_3     = 1u << 2; // 11100000 100_____
+    constexpr unsigned char TOO_LARGE      = 1u << 3; // 11110100 1001____
+    constexpr unsigned char SURROGATE      = 1u << 4; // 11101101 101_____
+    constexpr unsigned char OVERLONG_2     = 1u << 5; // 1100000_ 10______
+    constexpr unsigned char TOO_LARGE_1000 = 1u << 6; // 11110101 1000____
+    constexpr unsigned char OVERLONG_4     = 1u << 6; // 11110000 1000____
+    constexpr unsigned char TWO_CONTS      = 1u << 7; // 10______ 10______
+    constexpr unsigned char CARRY = TOO_SHORT | TOO_LONG | TWO_CONTS;
+
+    // indexed by the high nibble of the first byte
+    alignas(16) static const unsigned char byte_1_high[16] = {
+        TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,     // 0___ ASCII
+        TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+        TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS, // 10__ continuation
+        TOO_SHORT | OVERLONG_2,                     // 1100
+        TOO_SHORT,                                  // 1101
+        TOO_SHORT | OVERLONG_3 | SURROGATE,         // 1110
+        TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4 // 1111
+    };
+    // indexed by the low nibble of the first byte
+    alignas(16) static const unsigned char byte_1_low[16] = {
+        CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4, // 0000
+        CARRY | OVERLONG_2,                           // 0001
+        CARRY,                                        // 0010
+        CARRY,                                        // 0011
+        CARRY | TOO_LARGE,                            // 0100
+        CARRY | TOO_LARGE | TOO_LARGE_1000,           // 0101
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,           // 1___
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE, // 1101
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000
+    };
+    // indexed by the high nibble of the second byte
+    alignas(16) static const unsigned char byte_2_high[16] = {
+        TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, // 0___ ASCII
+        TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+        TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4, // 1000
+        TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE, // 1001
+        TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE  | TOO_LARGE, // 101_
+        TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE  | TOO_LARGE,
+        TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT  // 11__ leading byte
+    };
+    // a leading byte in the last 3 bytes needs the next block.
+    alignas(32) static const unsigned char max_last[32] = {
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF0 - 1, 0xE0 - 1, 0xC0 - 1
+    };
+
+    const auto load16 = [](const unsigned char* p) noexcept {
+        return _mm256_broadcastsi128_si256(
+            _mm_load_si128(reinterpret_cast<const __m128i*>(p)));
+    };
+    const __m256i tbl_1_high = load16(byte_1_high);
+    const __m256i tbl_1_low  = load16(byte_1_low);
+    const __m256i tbl_2_high = load16(byte_2_high);
+    const __m256i incomplete_max =
+        _mm256_load_si256(reinterpret_cast<const __m256i*>(max_last));
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    const __m256i msb    = _mm256_set1_epi8(static_cast<char>(0x80));
+    const __m256i third  = _mm256_set1_epi8(static_cast<char>(0xE0 - 0x80));
+    const __m256i fourth = _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80));
+
+    const auto begin = first;
+    __m256i prev_input      = _mm256_setzero_si256();
+    __m256i prev_incomplete = _mm256_setzero_si256();
+    for(; last - first >= 32; first += 32)
+    {
+        const __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+        __m256i error;
+        if(_mm256_movemask_epi8(input) == 0)
+        {
+            // a sequence cut at the end of the last block is not continued
+            error = prev_incomplete;
+            prev_incomplete = _mm256_setzero_si256();
+        }
+        else
+        {
+            // the bytes 1, 2, and 3 before each byte. [prev.hi, input.lo]
+            const __m256i shifted = _mm256_permute2x128_si256(prev_input, input, 0x21);
+            const __m256i prev1 = _mm256_alignr_epi8(input, shifted, 15);
+            const __m256i prev2 = _mm256_alignr_epi8(input, shifted, 14);
+            const __m256i prev3 = _mm256_alignr_epi8(input, shifted, 13);
+
+            const __m256i special = _mm256_and_si256(_mm256_and_si256(
+                _mm256_shuffle_epi8(tbl_1_high, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble)),
+                _mm256_shuffle_epi8(tbl_1_low,  _mm256_and_si256(prev1, nibble))),
+                _mm256_shuffle_epi8(tbl_2_high, _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble)));
+
+            // >= 0x80 only if prev2 >= 0xE0 or prev3 >= 0xF0
+            const __m256i must23 = _mm256_or_si256(
+                _mm256_subs_epu8(prev2, third), _mm256_subs_epu8(prev3, fourth));
+
+            error = _mm256_xor_si256(_mm256_and_si256(must23, msb), special);
+            prev_incomplete = _mm256_subs_epu8(input, incomplete_max);
+        }
+        if( ! _mm256_testz_si256(error, error))
+        {
+            break;
+        }
+        prev_input = input;
+    }
+
+    // go back to the start of the character that `first` is in, if any.
+    // The bytes before `first` are valid except for a cut sequence at the end.
+    auto p = first;
+    for(int i=0; i<3 && p != begin; ++i)
+    {
+        --p;
+        if((*p & 0xC0) != 0x80)
+        {
+            return p;
+        }
+    }
+    // 3 continuation bytes end a 4-byte character.
+    return first;
+}
+#endif
+
+TOML11_INLINE unsigned char const* find_invalid_utf8(
+        unsigned char const* first, unsigned char const* last) noexcept
+{
+#if defined(TOML11_SIMD_AVX2)
+    first = skip_valid_utf8_avx2(first, last);
+#endif
+
+    // the same ranges as syntax::non_ascii.
+    const auto in_range = [](const unsigned char c,
+            const unsigned char lo, const unsigned char hi) noexcept
+    {
+        return lo <= c && c <= hi;
+    };
+
+    while(true)
+    {
+        first = find_first_non_ascii(first, last);
+        if(first == last)
+        {
+            return last;
+        }
+
+        // non-ASCII characters tend to come in a row.
+        while(first != last && *first >= 0x80)
+        {
+            const auto b1 = *first;
+            const auto len = last - first;
+            if(in_range(b1, 0xC2, 0xDF))
+            {
+                if(len < 2 || ! in_range(first[1], 0x80, 0xBF))
+                {
+                    return first;
+                }
+                first += 2;
+            }
+            else if(in_range(b1, 0xE0, 0xEF))
+            {
+                const unsigned char lo = (b1 == 0xE0) ? 0xA0 : 0x80;
+                const unsigned char hi = (b1 == 0xED) ? 0x9F : 0xBF;
+                if(len < 3 || ! in_range(first[1], lo, hi) ||
+                              ! in_range(first[2], 0x80, 0xBF))
+                {
+                    return first;
+                }
+                first += 3;
+            }
+            else if(in_range(b1, 0xF0, 0xF4))
+            {
+                const unsigned char lo = (b1 == 0xF0) ? 0x90 : 0x80;
+                const unsigned char hi = (b1 == 0xF4) ? 0x8F : 0xBF;
+                if(len < 4 || ! in_range(first[1], lo, hi) ||
+                              ! in_range(first[2], 0x80, 0xBF) ||
+                              ! in_range(first[3], 0x80, 0xBF))
+                {
+                    return first;
+                }
+                first += 4;
+            }
+            else // 0x80-0xC1 or 0xF5-0xFF
+            {
+                return first;
+            }
+        }
+    }
+}
+
+} // TOML11_SIMD_NAMESPACE
+} // detail
+} // TOML11_INLINE_VERSION_NAMESPACE
+} // toml
+#endif // TOML11_SIMD_IMPL_HPP
@@ -0,0 +1,251 @@
+#ifndef TOML11_SOURCE_BUFFER_IMPL_HPP
+#define TOML11_SOURCE_BUFFER_IMPL_HPP
+
+#include "../fwd/source_buffer_fwd.hpp"
+#include "../simd.hpp"
+#include "../version.hpp"
+
+#include <algorithm>
+#include <ios>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+#include <cassert>
+
+#if defined(TOML11_HAS_MMAP)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace toml
+{
+inline namespace TOML11_INLINE_VERSION_NAMESPACE
+{
+namespace detail
+{
+
+TOML11_INLINE source_buffer::~source_buffer()
+{
+    delete this->newlines_.load(std::memory_order_acquire);
+}
+
+TOML11_INLINE source_buffer::const_reference
+source_buffer::at(const std::size_t i) const
+{
+    if(this->size_ <= i)
+    {
+        throw std::out_of_range("source_buffer::at: index " + std::to_string(i)
+                + " exceeds size " + std::to_string(this->size_));
+    }
+    if( ! this->has_text())
+    {
+        throw std::out_of_range("source_buffer::at: the text is not kept");
+    }
+    return this->data_[i];
+}
+
+TOML11_INLINE std::vector<std::size_t> const& source_buffer::newlines() const
+{
+    const auto found = this->newlines_.load(std::memory_order_acquire);
+    if(found)
+    {
+        return *found;
+    }
+
+    std::unique_ptr<std::vector<std::size_t>> built(new std::vector<std::size_t>{});
+    const auto first = this->data_;
+    const auto last  = this->data_ + this->size_;
+    for(auto nl = find_newline(first, last); nl != last; nl = find_newline(nl + 1, last))
+    {
+        built->push_back(static_cast<std::size_t>(nl - first));
+    }
+    built->shrink_to_fit();
+
+    std::vector<std::size_t> const* expected = nullptr;
+    if(this->newlines_.compare_exchange_strong(expected, built.get(),
+            std::memory_order_acq_rel, std::memory_order_acquire))
+    {
+        return *built.release();
+    }
+    return *expected; // another thread has built it first
+}
+
+TOML11_INLINE std::size_t source_buffer::line_number(const std::size_t offset) const
+{
+    assert(offset <= this->size_);
+    const auto& nls = this->newlines();
+    const auto iter = std::lower_bound(nls.begin(), nls.end(), offset);
+    return 1 + static_cast<std::size_t>(std::distance(nls.begin(), iter));
+}
+
+TOML11_INLINE std::size_t source_buffer::line_begin(const std::size_t offset) const
+{
+    assert(offset <= this->size_);
+    const auto& nls = this->newlines();
+    const auto iter = std::lower_bound(nls.begin(), nls.end(), offset);
+    return (iter == nls.begin()) ? 0 : *std::prev(iter) + 1;
+}
+
+TOML11_INLINE std::size_t source_buffer::line_end(const std::size_t offset) const
+{
+    assert(offset <= this->size_);
+    const auto& nls = this->newlines();
+    const auto iter = std::lower_bound(nls.begin(), nls.end(), offset);
+    return (iter == nls.end()) ? this->size_ : *iter;
+}
+
+TOML11_INLINE std::shared_ptr<const source_buffer>
+map_file(const std::string& fname)
+{
+#if defined(TOML11_HAS_MMAP)
+    const int fd = ::open(fname.c_str(), O_RDONLY);
+    if(fd < 0)
+    {
+        return nullptr;
+    }
+
+    // we cannot map pipes, devices, or something that does not have a size.
+    struct stat st;
+    if(::fstat(fd, &st) != 0 || ! S_ISREG(st.st_mode) || st.st_size <= 0)
+    {
+        ::close(fd);
+        return nullptr;
+    }
+    const auto size = static_cast<std::size_t>(st.st_size);
+
+    void* addr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // the mapping remains valid after closing fd
+    if(addr == MAP_FAILED)
+    {
+        return nullptr;
+    }
+    // the parser reads the file from the beginning to the end.
+    // It's just a hint, so we can ignore an error.
+    (void)::posix_madvise(addr, size, POSIX_MADV_SEQUENTIAL);
+
+    std::shared_ptr<const void> owner(static_cast<const void*>(addr),
+        [size](const void* p) {
+            ::munmap(const_cast<void*>(p), size);
+        });
+    return std::make_shared<const source_buffer>(
+        static_cast<const source_buffer::char_type*>(addr), size,
+        std::move(owner));
+#else
+    (void)fname;
+    return nullptr;
+#endif
+}
+
+TOML11_INLINE result<source_buffer::storage_type, none_t>
+read_stream(std::istream& is)
+{
+    constexpr std::size_t block_size = 64 * 1024;
+
+    // reading until EOF sets failbit. to avoid throwing an exception, we
+    // turn it off while reading and restore it later.
+    const auto mask = is.exceptions();
+    is.exceptions(std::ios_base::goodbit);
+
+    source_buffer::storage_type buf;
+
+    // if it is seekable, reserve the space to avoid re-allocation.
+    // we add a block to detect EOF without growing the buffer.
+    const auto beg = is.tellg();
+    if(beg != std::istream::pos_type(-1) && is.seekg(0, std::ios_base::end))
+    {
+        const auto end = is.tellg();
+        if( ! is.seekg(beg))
+        {
+            is.exceptions(mask);
+            return err();
+        }
+        if(beg <= end)
+        {
+            buf.reserve(static_cast<std::size_t>(end - beg) + block_size);
+        }
+    }
+    is.clear(is.rdstate() & std::ios_base::badbit);
+
+    while(is.good())
+    {
+        const auto size  = buf.size();
+        const auto block = (std::max)(block_size, buf.capacity() - size);
+        buf.resize(size + block);
+
+        is.read(reinterpret_cast<char*>(buf.data() + size),
+                static_cast<std::streamsize>(block));
+        const auto n = static_cast<std::size_t>(is.gcount());
+        buf.resize(size + n);
+
+        if(n < block)
+        {
+            break;
+        }
+    }
+
+    // the whole content has been read. leave the stream in a good state.
+    const bool failed = is.bad();
+    if( ! failed)
+    {
+        is.clear();
+    }
+    is.exceptions(mask);
+
+    if(failed)
+    {
+        return err();
+    }
+    return ok(std::move(buf));
+}
+
+TOML11_INLINE result<source_buffer::storage_type, none_t>
+read_file(std::FILE* fp)
+{
+    constexpr std::size_t block_size = 64 * 1024;
+
+    source_buffer::storage_type buf;
+
+    // if it is seekable, reserve the space to avoid re-allocation.
+    // we add a block to detect EOF without growing the buffer.
+    const long beg = std::ftell(fp);
+    if(beg != -1L && std::fseek(fp, 0, SEEK_END) == 0)
+    {
+        const long end = std::ftell(fp);
+        if(std::fseek(fp, beg, SEEK_SET) != 0)
+        {
+            return err();
+        }
+        if(beg <= end)
+        {
+            buf.reserve(static_cast<std::size_t>(end - beg) + block_size);
+        }
+    }
+
+    while(true)
+    {
+        const auto size  = buf.size();
+        const auto block = (std::max)(block_size, buf.capacity() - size);
+        buf.resize(size + block);
+
+        const auto n = std::fread(buf.data() + size, sizeof(char), block, fp);
+        buf.resize(size + n);
+
+        if(n < block)
+        {
+            if(std::ferror(fp))
+            {
+                return err();
+            }
+            break;
+        }
+    }
+    return ok(std::move(buf));
+}
+
+} // detail
+} // TOML11_INLINE_VERSION_NAMESPACE
+} // toml
+#endif // TOML11_SOURCE_BUFFER_IMPL_HPP
@@ -706,6 +706,7 @@ TOML11_INLINE std::uint32_t non_ascii_key_char::read_utf8(location& loc) const
     }
     else if((b1 >> 5) == 6) // 0b110 == 6
     {
+        if(loc.eof()) {return 0xFFFFFFFF;}
         const auto b2 = loc.current(); loc.advance(1);
 
         const std::uint32_t c1 = b1 & ((1 << 5) - 1);
@@ -758,6 +759,28 @@ TOML11_INLINE std::uint32_t non_ascii_key_char::read_utf8(location& loc) const
     }
 }
 
+TOML11_INLINE bool is_non_ascii_key_codepoint(const std::uint32_t cp) noexcept
+{
+    // ALPHA / DIGIT / %x2D / %x5F    ; a-z A-Z 0-9 - _
+    // / %xB2 / %xB3 / %xB9 / %xBC-BE ; superscript digits, fractions
+    // / %xC0-D6 / %xD8-F6 / %xF8-37D ; non-symbol chars in Latin block
+    // / %x37F-1FFF                   ; exclude GREEK QUESTION MARK, which is basically a semi-colon
+    // / %x200C-200D / %x203F-2040    ; from General Punctuation Block, include the two tie symbols and ZWNJ, ZWJ
+    // / %x2070-218F / %x2460-24FF    ; include super-/subscripts, letterlike/numberlike forms, enclosed alphanumerics
+    // / %x2C00-2FEF / %x3001-D7FF    ; skip arrows, math, box drawing etc, skip 2FF0-3000 ideographic up/down markers and spaces
+    // / %xF900-FDCF / %xFDF0-FFFD    ; skip D800-DFFF surrogate block, E000-F8FF Private Use area, FDD0-FDEF intended for process-internal use (unicode)
+    // / %x10000-EFFFF                ; all chars outside BMP range, excluding Private Use planes (F0000-10FFFF)
+
+    return cp == 0xB2 || cp == 0xB3 || cp == 0xB9 || (0xBC <= cp && cp <= 0xBE) ||
+           (0xC0    <= cp && cp <= 0xD6  ) || (0xD8 <= cp && cp <= 0xF6) || (0xF8 <= cp && cp <= 0x37D) ||
+           (0x37F   <= cp && cp <= 0x1FFF) ||
+           (0x200C  <= cp && cp <= 0x200D) || (0x203F <= cp && cp <= 0x2040) ||
+           (0x2070  <= cp && cp <= 0x218F) || (0x2460 <= cp && cp <= 0x24FF) ||
+           (0x2C00  <= cp && cp <= 0x2FEF) || (0x3001 <= cp && cp <= 0xD7FF) ||
+           (0xF900  <= cp && cp <= 0xFDCF) || (0xFDF0 <= cp && cp <= 0xFFFD) ||
+           (0x10000 <= cp && cp <= 0xEFFFF);
+}
+
 TOML11_INLINE region non_ascii_key_char::scan(location& loc) const
 {
     if(loc.eof()) {return region{};}
@@ -771,24 +794,7 @@ TOML11_INLINE region non_ascii_key_char::scan(location& loc) const
         return region{};
     }
 
-    // ALPHA / DIGIT / %x2D / %x5F    ; a-z A-Z 0-9 - _
-    // / %xB2 / %xB3 / %xB9 / %xBC-BE ; superscript digits, fractions
-    // / %xC0-D6 / %xD8-F6 / %xF8-37D ; non-symbol chars in Latin block
-    // / %x37F-1FFF                   ; exclude GREEK QUESTION MARK, which is basically a semi-colon
-    // / %x200C-200D / %x203F-2040    ; from General Punctuation Block, include the two tie symbols and ZWNJ, ZWJ
-    // / %x2070-218F / %x2460-24FF    ; include super-/subscripts, letterlike/numberlike forms, enclosed alphanumerics
-    // / %x2C00-2FEF / %x3001-D7FF    ; skip arrows, math, box drawing etc, skip 2FF0-3000 ideographic up/down markers and spaces
-    // / %xF900-FDCF / %xFDF0-FFFD    ; skip D800-DFFF surrogate block, E000-F8FF Private Use area, FDD0-FDEF intended for process-internal use (unicode)
-    // / %x10000-EFFFF                ; all chars outside BMP range, excluding Private Use planes (F0000-10FFFF)
-
-    if(cp == 0xB2 || cp == 0xB3 || cp == 0xB9 || (0xBC <= cp && cp <= 0xBE) ||
-       (0xC0    <= cp && cp <= 0xD6  ) || (0xD8 <= cp && cp <= 0xF6) || (0xF8 <= cp && cp <= 0x37D) ||
-       (0x37F   <= cp && cp <= 0x1FFF) ||
-       (0x200C  <= cp && cp <= 0x200D) || (0x203F <= cp && cp <= 0x2040) ||
-       (0x2070  <= cp && cp <= 0x218F) || (0x2460 <= cp && cp <= 0x24FF) ||
-       (0x2C00  <= cp && cp <= 0x2FEF) || (0x3001 <= cp && cp <= 0xD7FF) ||
-       (0xF900  <= cp && cp <= 0xFDCF) || (0xFDF0 <= cp && cp <= 0xFFFD) ||
-       (0x10000 <= cp && cp <= 0xEFFFF) )
+    if(is_non_ascii_key_codepoint(cp))
     {
         return region(first, loc);
     }
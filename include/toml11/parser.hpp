@@ -7,11 +7,15 @@
 #include "region.hpp"
 #include "result.hpp"
 #include "scanner.hpp"
+#include "simd.hpp"
 #include "skip.hpp"
+#include "source_buffer.hpp"
+#include "static_syntax.hpp"
 #include "syntax.hpp"
 #include "value.hpp"
 #include "version.hpp"
 
+#include <algorithm>
 #include <fstream>
 #include <sstream>
 
@@ -22,6 +26,10 @@
 #include <filesystem>
 #endif
 
+#if defined(TOML11_HAS_STRING_VIEW)
+#include <string_view>
+#endif
+
 namespace toml
 {
 inline namespace TOML11_INLINE_VERSION_NAMESPACE
@@ -91,6 +99,156 @@ error_info make_syntax_error(std::string title,
         std::move(title), std::move(src), std::move(msg), std::move(suffix));
 }
 
+// A region that is used only to be stored in a value. If TC does not track
+// locations, the value discards it, so it is not built at all.
+template<typename TC>
+cxx::enable_if_t<tracks_location<TC>::value, region>
+make_value_region(const cursor& first, const location& last)
+{
+    return region(first, last);
+}
+template<typename TC>
+cxx::enable_if_t<cxx::negation<tracks_location<TC>>::value, region>
+make_value_region(const cursor&, const location&) noexcept
+{
+    return region();
+}
+
+// Integer digits are read in a single pass over the token. It counts the
+// digits for integer_format_info::width and the ones after the last `_` for
+// spacer. The syntax, including the position of `_`, has already been checked
+// by the scanner.
+//
+// If TC::parse_int is the default one and integer_type is a built-in signed
+// integer, the value is accumulated in the same loop by int_accumulator, as
+// read_int does. Otherwise the digits without `_` are passed to TC::parse_int.
+
+template<typename TC>
+using is_accumulatable_integer = cxx::conjunction<
+        has_default_parse_int<TC>,
+        is_builtin_integer<typename TC::integer_type>,
+        std::is_signed<typename TC::integer_type>
+    >;
+
+// `loc` points the next character of the token and is used for an error.
+template<typename TC>
+result<typename TC::integer_type, error_info>
+read_integer_token_string(const token_view tok, const std::uint8_t base,
+                          const location& loc, integer_format_info& fmt)
+{
+    std::size_t i = (base == 10) ? 0 : 2; // skip `0x`, `0o`, and `0b`
+
+    fmt.width = tok.size() - i; // the sign is counted
+    bool lower = false;
+    bool upper = false;
+    std::string str;
+    str.reserve(tok.size() - i);
+    for(; i < tok.size(); ++i)
+    {
+        const char c = tok[i];
+        if(c == '_')
+        {
+            fmt.width -= 1;
+            fmt.spacer = tok.size() - 1 - i;
+            continue;
+        }
+        lower = lower || ('a' <= c);
+        upper = upper || ('A' <= c && c <= 'F');
+
+        // skip zeros at the MSB of bin, oct, and hex
+        if(base != 10 && str.empty() && c == '0')
+        {
+            continue;
+        }
+        str.push_back(c);
+    }
+    if(base == 16)
+    {
+        // if both upper and lower case letters are found, set upper=true.
+        fmt.uppercase = ! lower || upper;
+    }
+
+    // 0x0000_0000 becomes empty.
+    if(str.empty()) { str = "0"; }
+
+    return detail::call_parse_int<TC>(str, region(loc), base);
+}
+
+template<typename TC>
+cxx::enable_if_t<is_accumulatable_integer<TC>::value,
+    result<typename TC::integer_type, error_info>>
+read_integer_token(const token_view tok, const std::uint8_t base,
+                   const location& loc, integer_format_info& fmt)
+{
+    using integer_type = typename TC::integer_type;
+
+    std::size_t i = (base == 10) ? 0 : 2; // skip `0x`, `0o`, and `0b`
+    bool negative = false;
+    if(base == 10 && (tok.front() == '+' || tok.front() == '-'))
+    {
+        negative = (tok.front() == '-');
+        ++i;
+    }
+
+    fmt.width = tok.size() - ((base == 10) ? 0 : 2); // the sign is counted
+    bool lower = false;
+    bool upper = false;
+    int_accumulator<integer_type> acc(base, negative);
+    for(; i < tok.size(); ++i)
+    {
+        const char c = tok[i];
+        if(c == '_')
+        {
+            fmt.width -= 1;
+            fmt.spacer = tok.size() - 1 - i;
+            continue;
+        }
+        lower = lower || ('a' <= c);
+        upper = upper || ('A' <= c && c <= 'F');
+
+        assert(int_digit_value(c) < base);
+        if( ! acc.push(int_digit_value(c)))
+        {
+            // too large. TC::parse_int reports it in the same way as read_int.
+            return read_integer_token_string<TC>(tok, base, loc, fmt);
+        }
+    }
+    if(base == 16)
+    {
+        // if both upper and lower case letters are found, set upper=true.
+        fmt.uppercase = ! lower || upper;
+    }
+    return ok(acc.value());
+}
+
+template<typename TC>
+cxx::enable_if_t<cxx::negation<is_accumulatable_integer<TC>>::value,
+    result<typename TC::integer_type, error_info>>
+read_integer_token(const token_view tok, const std::uint8_t base,
+                   const location& loc, integer_format_info& fmt)
+{
+    return read_integer_token_string<TC>(tok, base, loc, fmt);
+}
+
+// The whole input is checked once before parsing. After that, the scanners
+// can take any byte >= 0x80 as a part of a valid UTF-8 character.
+inline result<none_t, error_info> validate_utf8(location loc)
+{
+    const auto& src  = *loc.source();
+    const auto first = src.data() + loc.get_location();
+    const auto last  = src.data() + src.size();
+
+    const auto found = find_invalid_utf8(first, last);
+    if(found == last)
+    {
+        return ok(none_t{});
+    }
+    loc.advance(static_cast<std::size_t>(found - first));
+    return err(make_error_info("toml::parse: invalid UTF-8 sequence found",
+        source_location(region(loc)), "here",
+        "Hint: TOML file must be a valid UTF-8 encoded Unicode document."));
+}
+
 
 /* ============================================================================
  *                             _
@@ -99,20 +257,29 @@ error_info make_syntax_error(std::string title,
  * \__\___/_|_|_|_|_|_\___|_||_\__|
  */
 
+// The text of a comment is copied only if the comment container keeps it.
+// discard_comments skips it. The comment is still checked by the scanner.
+template<typename Comments>
+void push_comment(Comments& com, const region& reg)
+{
+    com.push_back(reg.as_string());
+}
+inline void push_comment(discard_comments&, const region&) noexcept {}
+
 template<typename TC>
-result<cxx::optional<std::string>, error_info>
+result<cxx::optional<region>, error_info>
 parse_comment_line(location& loc, context<TC>& ctx)
 {
     const auto& spec = ctx.toml_spec();
-    const auto first = loc;
+    const auto first = loc.get_cursor();
 
     skip_whitespace(loc, ctx);
 
-    const auto com_reg = syntax::comment(spec).scan(loc);
+    auto com_reg = static_scan<static_syntax::comment>(loc, spec);
     if(com_reg.is_ok())
     {
         // once comment started, newline must follow (or reach EOF).
-        if( ! loc.eof() && ! syntax::newline(spec).scan(loc).is_ok())
+        if( ! loc.eof() && ! static_skip<static_syntax::newline>(loc, spec))
         {
             while( ! loc.eof()) // skip until newline to continue parsing
             {
@@ -124,12 +291,12 @@ parse_comment_line(location& loc, context<TC>& ctx)
                 source_location(region(loc)), "but got this",
                 "Hint: most of the control characters are not allowed in comments"));
         }
-        return ok(cxx::optional<std::string>(com_reg.as_string()));
+        return ok(cxx::optional<region>(std::move(com_reg)));
     }
     else
     {
-        loc = first; // rollback whitespace to parse indent
-        return ok(cxx::optional<std::string>(cxx::make_nullopt()));
+        loc.reset(first); // rollback whitespace to parse indent
+        return ok(cxx::optional<region>(cxx::make_nullopt()));
     }
 }
 
@@ -148,7 +315,7 @@ parse_boolean(location& loc, const context<TC>& ctx)
 
     // ----------------------------------------------------------------------
     // check syntax
-    auto reg = syntax::boolean(spec).scan(loc);
+    auto reg = static_scan<static_syntax::boolean>(loc, spec);
     if( ! reg.is_ok())
     {
         return err(make_syntax_error("toml::parse_boolean: "
@@ -158,7 +325,7 @@ parse_boolean(location& loc, const context<TC>& ctx)
 
     // ----------------------------------------------------------------------
     // it matches. gen value
-    const auto str = reg.as_string();
+    const auto str = reg.as_view();
     const auto val = [&str]() {
         if(str == "true")
         {
@@ -190,9 +357,9 @@ template<typename TC>
 result<basic_value<TC>, error_info>
 parse_bin_integer(location& loc, const context<TC>& ctx)
 {
-    const auto first = loc;
+    const auto first = loc.get_cursor();
     const auto& spec = ctx.toml_spec();
-    auto reg = syntax::bin_int(spec).scan(loc);
+    auto reg = static_scan<static_syntax::bin_int>(loc, spec);
     if( ! reg.is_ok())
     {
         return err(make_syntax_error("toml::parse_bin_integer: "
@@ -200,35 +367,17 @@ parse_bin_integer(location& loc, const context<TC>& ctx)
             syntax::bin_int(spec), loc));
     }
 
-    auto str = reg.as_string();
-
     integer_format_info fmt;
-    fmt.fmt   = integer_format::bin;
-    fmt.width = str.size() - 2 - static_cast<std::size_t>(std::count(str.begin(), str.end(), '_'));
-
-    const auto first_underscore = std::find(str.rbegin(), str.rend(), '_');
-    if(first_underscore != str.rend())
-    {
-        fmt.spacer = static_cast<std::size_t>(std::distance(str.rbegin(), first_underscore));
-    }
-
-    // skip prefix `0b` and zeros and underscores at the MSB
-    str.erase(str.begin(), std::find(std::next(str.begin(), 2), str.end(), '1'));
-
-    // remove all `_` before calling TC::parse_int
-    str.erase(std::remove(str.begin(), str.end(), '_'), str.end());
-
-    // 0b0000_0000 becomes empty.
-    if(str.empty()) { str = "0"; }
+    fmt.fmt = integer_format::bin;
 
-    const auto val = TC::parse_int(str, source_location(region(loc)), 2);
+    const auto val = read_integer_token<TC>(reg.as_view(), 2, loc, fmt);
     if(val.is_ok())
     {
         return ok(basic_value<TC>(val.as_ok(), std::move(fmt), {}, std::move(reg)));
     }
     else
     {
-        loc = first;
+        loc.reset(first);
         return err(val.as_err());
     }
 }
@@ -239,9 +388,9 @@ template<typename TC>
 result<basic_value<TC>, error_info>
 parse_oct_integer(location& loc, const context<TC>& ctx)
 {
-    const auto first = loc;
+    const auto first = loc.get_cursor();
     const auto& spec = ctx.toml_spec();
-    auto reg = syntax::oct_int(spec).scan(loc);
+    auto reg = static_scan<static_syntax::oct_int>(loc, spec);
     if( ! reg.is_ok())
     {
         return err(make_syntax_error("toml::parse_oct_integer: "
@@ -249,38 +398,17 @@ parse_oct_integer(location& loc, const context<TC>& ctx)
             syntax::oct_int(spec), loc));
     }
 
-    auto str = reg.as_string();
-
     integer_format_info fmt;
-    fmt.fmt   = integer_format::oct;
-    fmt.width = str.size() - 2 - static_cast<std::size_t>(std::count(str.begin(), str.end(), '_'));
-
-    const auto first_underscore = std::find(str.rbegin(), str.rend(), '_');
-    if(first_underscore != str.rend())
-    {
-        fmt.spacer = static_cast<std::size_t>(std::distance(str.rbegin(), first_underscore));
-    }
-
-    // skip prefix `0o` and zeros and underscores at the MSB
-    str.erase(str.begin(), std::find_if(
-                std::next(str.begin(), 2), str.end(), [](const char c) {
-                    return c != '0' && c != '_';
-                }));
-
-    // remove all `_` before calling TC::parse_int
-    str.erase(std::remove(str.begin(), str.end(), '_'), str.end());
+    fmt.fmt = integer_format::oct;
 
-    // 0o0000_0000 becomes empty.
-    if(str.empty()) { str = "0"; }
-
-    const auto val = TC::parse_int(str, source_location(region(loc)), 8);
+    const auto val = read_integer_token<TC>(reg.as_view(), 8, loc, fmt);
     if(val.is_ok())
     {
         return ok(basic_value<TC>(val.as_ok(), std::move(fmt), {}, std::move(reg)));
     }
     else
     {
-        loc = first;
+        loc.reset(first);
         return err(val.as_err());
     }
 }
@@ -289,9 +417,9 @@ template<typename TC>
 result<basic_value<TC>, error_info>
 parse_hex_integer(location& loc, const context<TC>& ctx)
 {
-    const auto first = loc;
+    const auto first = loc.get_cursor();
     const auto& spec = ctx.toml_spec();
-    auto reg = syntax::hex_int(spec).scan(loc);
+    auto reg = static_scan<static_syntax::hex_int>(loc, spec);
     if( ! reg.is_ok())
     {
         return err(make_syntax_error("toml::parse_hex_integer: "
@@ -299,46 +427,17 @@ parse_hex_integer(location& loc, const context<TC>& ctx)
             syntax::hex_int(spec), loc));
     }
 
-    auto str = reg.as_string();
-
     integer_format_info fmt;
-    fmt.fmt   = integer_format::hex;
-    fmt.width = str.size() - 2 - static_cast<std::size_t>(std::count(str.begin(), str.end(), '_'));
-
-    const auto first_underscore = std::find(str.rbegin(), str.rend(), '_');
-    if(first_underscore != str.rend())
-    {
-        fmt.spacer = static_cast<std::size_t>(std::distance(str.rbegin(), first_underscore));
-    }
-
-    // skip prefix `0x` and zeros and underscores at the MSB
-    str.erase(str.begin(), std::find_if(
-                std::next(str.begin(), 2), str.end(), [](const char c) {
-                    return c != '0' && c != '_';
-                }));
+    fmt.fmt = integer_format::hex;
 
-    // remove all `_` before calling TC::parse_int
-    str.erase(std::remove(str.begin(), str.end(), '_'), str.end());
-
-    // 0x0000_0000 becomes empty.
-    if(str.empty()) { str = "0"; }
-
-    // prefix zero and _ is removed. check if it uses upper/lower case.
-    // if both upper and lower case letters are found, set upper=true.
-    const auto lower_not_found = std::find_if(str.begin(), str.end(),
-        [](const char c) { return std::islower(static_cast<int>(c)) != 0; }) == str.end();
-    const auto upper_found = std::find_if(str.begin(), str.end(),
-        [](const char c) { return std::isupper(static_cast<int>(c)) != 0; }) != str.end();
-    fmt.uppercase = lower_not_found || upper_found;
-
-    const auto val = TC::parse_int(str, source_location(region(loc)), 16);
+    const auto val = read_integer_token<TC>(reg.as_view(), 16, loc, fmt);
     if(val.is_ok())
     {
         return ok(basic_value<TC>(val.as_ok(), std::move(fmt), {}, std::move(reg)));
     }
     else
     {
-        loc = first;
+        loc.reset(first);
         return err(val.as_err());
     }
 }
@@ -347,12 +446,12 @@ template<typename TC>
 result<basic_value<TC>, error_info>
 parse_dec_integer(location& loc, const context<TC>& ctx)
 {
-    const auto first = loc;
+    const auto first = loc.get_cursor();
     const auto& spec = ctx.toml_spec();
 
     // ----------------------------------------------------------------------
     // check syntax
-    auto reg = syntax::dec_int(spec).scan(loc);
+    auto reg = static_scan<static_syntax::dec_int>(loc, spec);
     if( ! reg.is_ok())
     {
         return err(make_syntax_error("toml::parse_dec_integer: "
@@ -362,26 +461,13 @@ parse_dec_integer(location& loc, const context<TC>& ctx)
 
     // ----------------------------------------------------------------------
     // it matches. gen value
-    auto str = reg.as_string();
-
     integer_format_info fmt;
     fmt.fmt = integer_format::dec;
-    fmt.width = str.size() - static_cast<std::size_t>(std::count(str.begin(), str.end(), '_'));
-
-    const auto first_underscore = std::find(str.rbegin(), str.rend(), '_');
-    if(first_underscore != str.rend())
-    {
-        fmt.spacer = static_cast<std::size_t>(std::distance(str.rbegin(), first_underscore));
-    }
 
-    // remove all `_` before calling TC::parse_int
-    str.erase(std::remove(str.begin(), str.end(), '_'), str.end());
-
-    auto src = source_location(region(loc));
-    const auto val = TC::parse_int(str, src, 10);
+    const auto val = read_integer_token<TC>(reg.as_view(), 10, loc, fmt);
     if(val.is_err())
     {
-        loc = first;
+        loc.reset(first);
         return err(val.as_err());
     }
 
@@ -390,19 +476,17 @@ parse_dec_integer(location& loc, const context<TC>& ctx)
 
     if(spec.ext_num_suffix && loc.current() == '_')
     {
-        const auto sfx_reg = syntax::num_suffix(spec).scan(loc);
+        const auto sfx_reg = static_scan<static_syntax::num_suffix>(loc, spec);
         if( ! sfx_reg.is_ok())
         {
-            loc = first;
+            loc.reset(first);
             return err(make_error_info("toml::parse_dec_integer: "
                 "invalid suffix: should be `_ non-digit-graph (graph | _graph)`",
                 source_location(region(loc)), "here"));
         }
-        auto sfx = sfx_reg.as_string();
+        const auto sfx = sfx_reg.as_view();
         assert( ! sfx.empty() && sfx.front() == '_');
-        sfx.erase(sfx.begin()); // remove the first `_`
-
-        fmt.suffix = sfx;
+        fmt.suffix = sfx.substr(1).as_string(); // remove the first `_`
     }
 
     return ok(basic_value<TC>(val.as_ok(), std::move(fmt), {}, std::move(reg)));
@@ -412,7 +496,7 @@ template<typename TC>
 result<basic_value<TC>, error_info>
 parse_integer(location& loc, const context<TC>& ctx)
 {
-    const auto first = loc;
+    const auto first = loc.get_cursor();
 
     if( ! loc.eof() && (loc.current() == '+' || loc.current() == '-'))
     {
@@ -428,14 +512,13 @@ parse_integer(location& loc, const context<TC>& ctx)
         if(loc.eof())
         {
             // `[+-]?0`. parse as an decimal integer.
-            loc = first;
+            loc.reset(first);
             return parse_dec_integer(loc, ctx);
         }
 
         const auto prefix = loc.current();
-        auto prefix_src = source_location(region(loc));
 
-        loc = first;
+        loc.reset(first);
 
         if(prefix == 'b') {return parse_bin_integer(loc, ctx);}
         if(prefix == 'o') {return parse_oct_integer(loc, ctx);}
@@ -450,7 +533,7 @@ parse_integer(location& loc, const context<TC>& ctx)
         }
     }
 
-    loc = first;
+    loc.reset(first);
     return parse_dec_integer(loc, ctx);
 }
 
@@ -468,43 +551,64 @@ parse_floating(location& loc, const context<TC>& ctx)
 {
     using floating_type = typename basic_value<TC>::floating_type;
 
-    const auto first = loc;
+    const auto first = loc.get_cursor();
     const auto& spec = ctx.toml_spec();
 
     // ----------------------------------------------------------------------
     // check syntax
     bool is_hex = false;
-    std::string str;
     region reg;
-    if(spec.ext_hex_float && literal("0x").scan(loc).is_ok())
+    if(spec.ext_hex_float && static_skip<static_scanner::literal<'0', 'x'>>(loc, spec))
     {
-        loc = first;
+        loc.reset(first);
         is_hex = true;
 
-        reg = syntax::hex_floating(spec).scan(loc);
+        reg = static_scan<static_syntax::hex_floating>(loc, spec);
         if( ! reg.is_ok())
         {
             return err(make_syntax_error("toml::parse_floating: "
                 "invalid hex floating: float must be like: 0xABCp-3f",
                 syntax::floating(spec), loc));
         }
-        str = reg.as_string();
     }
     else
     {
-        reg = syntax::floating(spec).scan(loc);
+        reg = static_scan<static_syntax::floating>(loc, spec);
         if( ! reg.is_ok())
         {
             return err(make_syntax_error("toml::parse_floating: "
                 "invalid floating: float must be like: -3.14159_26535, 6.022e+23, "
                 "inf, or nan (lowercase).", syntax::floating(spec), loc));
         }
-        str = reg.as_string();
     }
 
     // ----------------------------------------------------------------------
     // it matches. gen value
 
+    // remove all `_` before calling TC::parse_float, and find the decimal
+    // point and the exponent part in the same loop.
+    const auto view = reg.as_view();
+    std::string str;
+    str.reserve(view.size());
+    std::size_t decpoint = std::string::npos;
+    std::size_t exponent = std::string::npos;
+    for(const char c : view)
+    {
+        if(c == '_')
+        {
+            continue;
+        }
+        if(c == '.')
+        {
+            decpoint = str.size();
+        }
+        else if( ! is_hex && (c == 'e' || c == 'E'))
+        {
+            exponent = str.size();
+        }
+        str.push_back(c);
+    }
+
     floating_format_info fmt;
 
     if(is_hex)
@@ -514,8 +618,7 @@ parse_floating(location& loc, const context<TC>& ctx)
     else
     {
         // since we already checked that the string conforms the TOML standard.
-        if(std::find(str.begin(), str.end(), 'e') != str.end() ||
-           std::find(str.begin(), str.end(), 'E') != str.end())
+        if(exponent != std::string::npos)
         {
             fmt.fmt = floating_format::scientific; // use exponent part
         }
@@ -525,8 +628,6 @@ parse_floating(location& loc, const context<TC>& ctx)
         }
     }
 
-    str.erase(std::remove(str.begin(), str.end(), '_'), str.end());
-
     floating_type val{0};
 
     if(str == "inf" || str == "+inf")
@@ -606,10 +707,7 @@ parse_floating(location& loc, const context<TC>& ctx)
     {
         // set precision
         const auto has_sign = ! str.empty() && (str.front() == '+' || str.front() == '-');
-        const auto decpoint = std::find(str.begin(), str.end(), '.');
-        const auto exponent = std::find_if(str.begin(), str.end(),
-            [](const char c) { return c == 'e' || c == 'E'; });
-        if(decpoint != str.end() && exponent != str.end())
+        if(decpoint != std::string::npos && exponent != std::string::npos)
         {
             assert(decpoint < exponent);
         }
@@ -617,12 +715,12 @@ parse_floating(location& loc, const context<TC>& ctx)
         if(fmt.fmt == floating_format::scientific)
         {
             // total width
-            fmt.prec = static_cast<std::size_t>(std::distance(str.begin(), exponent));
+            fmt.prec = exponent;
             if(has_sign)
             {
                 fmt.prec -= 1;
             }
-            if(decpoint != str.end())
+            if(decpoint != std::string::npos)
             {
                 fmt.prec -= 1;
             }
@@ -634,11 +732,10 @@ parse_floating(location& loc, const context<TC>& ctx)
         else
         {
             // width after decimal point
-            fmt.prec = static_cast<std::size_t>(std::distance(std::next(decpoint), exponent));
+            fmt.prec = (std::min)(exponent, str.size()) - decpoint - 1;
         }
 
-        auto src = source_location(region(loc));
-        const auto res = TC::parse_float(str, src, is_hex);
+        const auto res = detail::call_parse_float<TC>(str, region(loc), is_hex);
         if(res.is_ok())
         {
             val = res.as_ok();
@@ -654,20 +751,18 @@ parse_floating(location& loc, const context<TC>& ctx)
 
     if(spec.ext_num_suffix && loc.current() == '_')
     {
-        const auto sfx_reg = syntax::num_suffix(spec).scan(loc);
+        const auto sfx_reg = static_scan<static_syntax::num_suffix>(loc, spec);
         if( ! sfx_reg.is_ok())
         {
             auto src = source_location(region(loc));
-            loc = first;
+            loc.reset(first);
             return err(make_error_info("toml::parse_floating: "
                 "invalid suffix: should be `_ non-digit-graph (graph | _graph)`",
                 std::move(src), "here"));
         }
-        auto sfx = sfx_reg.as_string();
+        const auto sfx = sfx_reg.as_view();
         assert( ! sfx.empty() && sfx.front() == '_');
-        sfx.erase(sfx.begin()); // remove the first `_`
-
-        fmt.suffix = sfx;
+        fmt.suffix = sfx.substr(1).as_string(); // remove the first `_`
     }
 
     return ok(basic_value<TC>(val, std::move(fmt), {}, std::move(reg)));
@@ -680,19 +775,33 @@ parse_floating(location& loc, const context<TC>& ctx)
  * |___/\__,_|\__\___|\__|_|_|_|_\___|
  */
 
+// The fields of date and time have fixed widths and the scanner has already
+// checked that they are digits, so they are read directly from the token.
+inline int read_fixed_digits(const token_view str,
+        const std::size_t pos, const std::size_t len) noexcept
+{
+    int val = 0;
+    for(std::size_t i=pos; i<pos+len; ++i)
+    {
+        assert('0' <= str[i] && str[i] <= '9');
+        val = val * 10 + (str[i] - '0');
+    }
+    return val;
+}
+
 // all the offset_datetime, local_datetime, local_date parses date part.
 template<typename TC>
 result<std::tuple<local_date, local_date_format_info, region>, error_info>
 parse_local_date_only(location& loc, const context<TC>& ctx)
 {
-    const auto first = loc;
+    const auto first = loc.get_cursor();
     const auto& spec = ctx.toml_spec();
 
     local_date_format_info fmt;
 
     // ----------------------------------------------------------------------
     // check syntax
-    auto reg = syntax::local_date(spec).scan(loc);
+    auto reg = static_scan<static_syntax::local_date>(loc, spec);
     if( ! reg.is_ok())
     {
         return err(make_syntax_error("toml::parse_local_date: "
@@ -702,39 +811,13 @@ parse_local_date_only(location& loc, const context<TC>& ctx)
 
     // ----------------------------------------------------------------------
     // it matches. gen value
-    const auto str = reg.as_string();
+    const auto str = reg.as_view();
 
     // 0123456789
     // yyyy-mm-dd
-    const auto year_r  = from_string<int>(str.substr(0, 4));
-    const auto month_r = from_string<int>(str.substr(5, 2));
-    const auto day_r   = from_string<int>(str.substr(8, 2));
-
-    if(year_r.is_err())
-    {
-        auto src = source_location(region(first));
-        return err(make_error_info("toml::parse_local_date: "
-            "failed to read year `" + str.substr(0, 4) + "`",
-            std::move(src), "here"));
-    }
-    if(month_r.is_err())
-    {
-        auto src = source_location(region(first));
-        return err(make_error_info("toml::parse_local_date: "
-            "failed to read month `" + str.substr(5, 2) + "`",
-            std::move(src), "here"));
-    }
-    if(day_r.is_err())
-    {
-        auto src = source_location(region(first));
-        return err(make_error_info("toml::parse_local_date: "
-            "failed to read day `" + str.substr(8, 2) + "`",
-            std::move(src), "here"));
-    }
-
-    const auto year  = year_r.unwrap();
-    const auto month = month_r.unwrap();
-    const auto day   = day_r.unwrap();
+    const auto year  = read_fixed_digits(str, 0, 4);
+    const auto month = read_fixed_digits(str, 5, 2);
+    const auto day   = read_fixed_digits(str, 8, 2);
 
     {
         // We briefly check whether the input date is valid or not.
@@ -761,7 +844,7 @@ parse_local_date_only(location& loc, const context<TC>& ctx)
 
         if((month < 1 || 12 < month) || (day < 1 || max_day < day))
         {
-            auto src = source_location(region(first));
+            auto src = source_location(region(location(loc, first)));
             return err(make_error_info("toml::parse_local_date: invalid date.",
                 std::move(src), "month must be 01-12, day must be any of "
                 "01-28,29,30,31 depending on the month/year."));
@@ -796,14 +879,14 @@ template<typename TC>
 result<std::tuple<local_time, local_time_format_info, region>, error_info>
 parse_local_time_only(location& loc, const context<TC>& ctx)
 {
-    const auto first = loc;
+    const auto first = loc.get_cursor();
     const auto& spec = ctx.toml_spec();
 
     local_time_format_info fmt;
 
     // ----------------------------------------------------------------------
     // check syntax
-    auto reg = syntax::local_time(spec).scan(loc);
+    auto reg = static_scan<static_syntax::local_time>(loc, spec);
     if( ! reg.is_ok())
     {
         if(spec.v1_1_0_make_seconds_optional)
@@ -822,35 +905,17 @@ parse_local_time_only(location& loc, const context<TC>& ctx)
 
     // ----------------------------------------------------------------------
     // it matches. gen value
-    const auto str = reg.as_string();
+    const auto str = reg.as_view();
 
     // at least we have HH:MM.
     // 01234
     // HH:MM
-    const auto hour_r   = from_string<int>(str.substr(0, 2));
-    const auto minute_r = from_string<int>(str.substr(3, 2));
-
-    if(hour_r.is_err())
-    {
-        auto src = source_location(region(first));
-        return err(make_error_info("toml::parse_local_time: "
-            "failed to read hour `" + str.substr(0, 2) + "`",
-            std::move(src), "here"));
-    }
-    if(minute_r.is_err())
-    {
-        auto src = source_location(region(first));
-        return err(make_error_info("toml::parse_local_time: "
-            "failed to read minute `" + str.substr(3, 2) + "`",
-            std::move(src), "here"));
-    }
-
-    const auto hour   = hour_r.unwrap();
-    const auto minute = minute_r.unwrap();
+    const auto hour   = read_fixed_digits(str, 0, 2);
+    const auto minute = read_fixed_digits(str, 3, 2);
 
     if((hour < 0 || 24 <= hour) || (minute < 0 || 60 <= minute))
     {
-        auto src = source_location(region(first));
+        auto src = source_location(region(location(loc, first)));
         return err(make_error_info("toml::parse_local_time: invalid time.",
             std::move(src), "hour must be 00-23, minute must be 00-59."));
     }
@@ -866,26 +931,18 @@ parse_local_time_only(location& loc, const context<TC>& ctx)
         fmt.subsecond_precision = 0;
         return ok(std::make_tuple(local_time(hour, minute, 0), std::move(fmt), std::move(reg)));
     }
-    assert(str.at(5) == ':');
+    assert(str[5] == ':');
 
     // we have at least `:SS` part. `.subseconds` are optional.
 
     // 0         1
     // 012345678901234
     // HH:MM:SS.subsec
-    const auto sec_r = from_string<int>(str.substr(6, 2));
-    if(sec_r.is_err())
-    {
-        auto src = source_location(region(first));
-        return err(make_error_info("toml::parse_local_time: "
-            "failed to read second `" + str.substr(6, 2) + "`",
-            std::move(src), "here"));
-    }
-    const auto sec = sec_r.unwrap();
+    const auto sec = read_fixed_digits(str, 6, 2);
 
     if(sec < 0 || 60 < sec) // :60 is allowed
     {
-        auto src = source_location(region(first));
+        auto src = source_location(region(location(loc, first)));
         return err(make_error_info("toml::parse_local_time: invalid time.",
                     std::move(src), "second must be 00-60."));
     }
@@ -897,46 +954,23 @@ parse_local_time_only(location& loc, const context<TC>& ctx)
         return ok(std::make_tuple(local_time(hour, minute, sec), std::move(fmt), std::move(reg)));
     }
 
-    assert(str.at(8) == '.');
-
-    auto secfrac = str.substr(9, str.size() - 9);
+    assert(str[8] == '.');
 
+    // subseconds longer than nanoseconds are truncated. shorter ones are
+    // read as if they are padded with zeros.
+    const auto subsec_len = str.size() - 9;
     fmt.has_seconds = true;
-    fmt.subsecond_precision = secfrac.size();
-
-    while(secfrac.size() < 9)
-    {
-        secfrac += '0';
-    }
-    assert(9 <= secfrac.size());
-    const auto ms_r = from_string<int>(secfrac.substr(0, 3));
-    const auto us_r = from_string<int>(secfrac.substr(3, 3));
-    const auto ns_r = from_string<int>(secfrac.substr(6, 3));
+    fmt.subsecond_precision = subsec_len;
 
-    if(ms_r.is_err())
-    {
-        auto src = source_location(region(first));
-        return err(make_error_info("toml::parse_local_time: "
-            "failed to read milliseconds `" + secfrac.substr(0, 3) + "`",
-            std::move(src), "here"));
-    }
-    if(us_r.is_err())
-    {
-        auto src = source_location(region(first));
-        return err(make_error_info("toml::parse_local_time: "
-            "failed to read microseconds`" + str.substr(3, 3) + "`",
-            std::move(src), "here"));
-    }
-    if(ns_r.is_err())
+    const auto subsec_digits = (std::min)(subsec_len, std::size_t(9));
+    int subsec = read_fixed_digits(str, 9, subsec_digits);
+    for(std::size_t i=subsec_digits; i<9; ++i)
     {
-        auto src = source_location(region(first));
-        return err(make_error_info("toml::parse_local_time: "
-            "failed to read nanoseconds`" + str.substr(6, 3) + "`",
-            std::move(src), "here"));
+        subsec *= 10;
     }
-    const auto ms = ms_r.unwrap();
-    const auto us = us_r.unwrap();
-    const auto ns = ns_r.unwrap();
+    const auto ms = subsec / 1000000;
+    const auto us = subsec / 1000 % 1000;
+    const auto ns = subsec % 1000;
 
     return ok(std::make_tuple(local_time(hour, minute, sec, ms, us, ns), std::move(fmt), std::move(reg)));
 }
@@ -945,8 +979,6 @@ template<typename TC>
 result<basic_value<TC>, error_info>
 parse_local_time(location& loc, const context<TC>& ctx)
 {
-    const auto first = loc;
-
     auto val_fmt_reg = parse_local_time_only(loc, ctx);
     if(val_fmt_reg.is_err())
     {
@@ -966,7 +998,7 @@ parse_local_datetime(location& loc, const context<TC>& ctx)
 {
     using char_type = location::char_type;
 
-    const auto first = loc;
+    const auto first = loc.get_cursor();
 
     local_datetime_format_info fmt;
 
@@ -1012,7 +1044,7 @@ parse_local_datetime(location& loc, const context<TC>& ctx)
 
     // ----------------------------------------------------------------------
 
-    region reg(first, loc);
+    auto reg = make_value_region<TC>(first, loc);
     local_datetime val(std::get<0>(date_fmt_reg.unwrap()),
                        std::get<0>(time_fmt_reg.unwrap()));
 
@@ -1025,7 +1057,7 @@ parse_offset_datetime(location& loc, const context<TC>& ctx)
 {
     using char_type = location::char_type;
 
-    const auto first = loc;
+    const auto first = loc.get_cursor();
     const auto& spec = ctx.toml_spec();
 
     offset_datetime_format_info fmt;
@@ -1080,7 +1112,7 @@ parse_offset_datetime(location& loc, const context<TC>& ctx)
     // ----------------------------------------------------------------------
     // offset part
 
-    const auto ofs_reg = syntax::time_offset(spec).scan(loc);
+    const auto ofs_reg = static_scan<static_syntax::time_offset>(loc, spec);
     if( ! ofs_reg.is_ok())
     {
         return err(make_syntax_error("toml::parse_offset_datetime: "
@@ -1088,32 +1120,20 @@ parse_offset_datetime(location& loc, const context<TC>& ctx)
             syntax::time_offset(spec), loc));
     }
 
-    const auto ofs_str = ofs_reg.as_string();
+    const auto ofs_str = ofs_reg.as_view();
 
     time_offset offset(0, 0);
 
     assert(ofs_str.size() != 0);
 
-    if(ofs_str.at(0) == char_type('+') || ofs_str.at(0) == char_type('-'))
+    if(ofs_str.front() == char_type('+') || ofs_str.front() == char_type('-'))
     {
-        const auto hour_r   = from_string<int>(ofs_str.substr(1, 2));
-        const auto minute_r = from_string<int>(ofs_str.substr(4, 2));
-        if(hour_r.is_err())
-        {
-            auto src = source_location(region(loc));
-            return err(make_error_info("toml::parse_offset_datetime: "
-                "Failed to read offset hour part", std::move(src), "here"));
-        }
-        if(minute_r.is_err())
-        {
-            auto src = source_location(region(loc));
-            return err(make_error_info("toml::parse_offset_datetime: "
-                "Failed to read offset minute part", std::move(src), "here"));
-        }
-        const auto hour   = hour_r.unwrap();
-        const auto minute = minute_r.unwrap();
+        // 012345
+        // +HH:MM
+        const auto hour   = read_fixed_digits(ofs_str, 1, 2);
+        const auto minute = read_fixed_digits(ofs_str, 4, 2);
 
-        if(ofs_str.at(0) == '+')
+        if(ofs_str.front() == '+')
         {
             offset = time_offset(hour, minute);
         }
@@ -1124,7 +1144,7 @@ parse_offset_datetime(location& loc, const context<TC>& ctx)
     }
     else
     {
-        assert(ofs_str.at(0) == char_type('Z') || ofs_str.at(0) == char_type('z'));
+        assert(ofs_str.front() == char_type('Z') || ofs_str.front() == char_type('z'));
     }
 
     if (offset.hour   < -24 || 24 < offset.hour ||
@@ -1138,7 +1158,7 @@ parse_offset_datetime(location& loc, const context<TC>& ctx)
 
     // ----------------------------------------------------------------------
 
-    region reg(first, loc);
+    auto reg = make_value_region<TC>(first, loc);
     offset_datetime val(local_datetime(std::get<0>(date_fmt_reg.unwrap()),
                                        std::get<0>(time_fmt_reg.unwrap())),
                                        offset);
@@ -1163,13 +1183,16 @@ parse_utf8_codepoint(const region& reg)
 
     // assert(reg.as_lines().size() == 1); // XXX heavy check
 
-    const auto str = reg.as_string();
+    const auto str = reg.as_view();
     assert( ! str.empty());
     assert(str.front() == 'u' || str.front() == 'U' || str.front() == 'x');
 
-    std::uint_least32_t codepoint;
-    std::istringstream iss(str.substr(1));
-    iss >> std::hex >> codepoint;
+    // the scanner has checked that it has 2, 4, or 8 hex digits.
+    std::uint_least32_t codepoint = 0;
+    for(const char c : str.substr(1))
+    {
+        codepoint = codepoint * 16 + static_cast<std::uint_least32_t>(int_digit_value(c));
+    }
 
     const auto to_char = [](const std::uint_least32_t i) noexcept -> char_type {
         const auto uc = static_cast<unsigned char>(i & 0xFF);
@@ -1249,7 +1272,7 @@ parse_escape_sequence(location& loc, const context<TC>& ctx)
     }
     else if(spec.v1_1_0_add_escape_sequence_x && loc.current() == 'x')
     {
-        const auto reg = syntax::escaped_x2(spec).scan(loc);
+        const auto reg = static_scan<static_syntax::escaped_x2>(loc, spec);
         if( ! reg.is_ok())
         {
             auto src = source_location(region(loc));
@@ -1266,7 +1289,7 @@ parse_escape_sequence(location& loc, const context<TC>& ctx)
     }
     else if(loc.current() == 'u')
     {
-        const auto reg = syntax::escaped_u4(spec).scan(loc);
+        const auto reg = static_scan<static_syntax::escaped_u4>(loc, spec);
         if( ! reg.is_ok())
         {
             auto src = source_location(region(loc));
@@ -1283,7 +1306,7 @@ parse_escape_sequence(location& loc, const context<TC>& ctx)
     }
     else if(loc.current() == 'U')
     {
-        const auto reg = syntax::escaped_U8(spec).scan(loc);
+        const auto reg = static_scan<static_syntax::escaped_U8>(loc, spec);
         if( ! reg.is_ok())
         {
             auto src = source_location(region(loc));
@@ -1318,158 +1341,236 @@ parse_escape_sequence(location& loc, const context<TC>& ctx)
     return ok(retval);
 }
 
+// Unescapes the body of a (multi-line) basic string in [loc, last) that is
+// already checked by the scanner. The runs between backslashes are copied at
+// once, and escape sequences are read from the source so that an error on
+// an invalid codepoint points to the actual file.
 template<typename TC>
-result<basic_value<TC>, error_info>
-parse_ml_basic_string(location& loc, const context<TC>& ctx)
+result<typename basic_value<TC>::string_type, error_info>
+parse_basic_string_body(location loc, location::char_type const* last,
+                        const context<TC>& ctx, const bool multiline)
 {
-    const auto first = loc;
+    using string_type = typename basic_value<TC>::string_type;
+    using char_type   = typename string_type::value_type;
+    static_assert(sizeof(char_type) == 1, "toml::parse: the spans of the "
+        "source are copied into string_type as-is; its value_type must be a "
+        "single byte.");
     const auto& spec = ctx.toml_spec();
+    const auto  src  = loc.source()->data();
 
-    string_format_info fmt;
-    fmt.fmt = string_format::multiline_basic;
-
-    auto reg = syntax::ml_basic_string(spec).scan(loc);
-    if( ! reg.is_ok())
+    string_type val;
+    while(true)
     {
-        return err(make_syntax_error("toml::parse_ml_basic_string: "
-            "invalid string format",
-            syntax::ml_basic_string(spec), loc));
+        const auto iter = src + loc.get_location();
+        const auto bs   = std::find(iter, last, '\\');
+        val.append(reinterpret_cast<const char_type*>(iter),
+                   static_cast<std::size_t>(bs - iter));
+        if(bs == last)
+        {
+            break;
+        }
+        loc.advance(static_cast<std::size_t>(bs - iter));
+
+        if(multiline) // remove whitespaces around escaped-newline
+        {
+            const auto nl = static_syntax::escaped_newline::scan(bs, last, spec);
+            if(nl)
+            {
+                loc.advance(static_cast<std::size_t>(nl - bs));
+                continue;
+            }
+        }
+
+        // syntax does not check its value. the unicode codepoint may be
+        // invalid, e.g. out-of-bound, [0xD800, 0xDFFF]
+        auto esc = parse_escape_sequence(loc, ctx);
+        if(esc.is_err())
+        {
+            return err(esc.unwrap_err());
+        }
+        val += esc.unwrap();
     }
+    return ok(val);
+}
 
-    // ----------------------------------------------------------------------
-    // it matches. gen value
+template<typename TC>
+result<basic_value<TC>, error_info>
+parse_ml_basic_string(location& loc, const context<TC>& ctx)
+{
+    const auto first = loc.get_cursor();
+    const auto& spec = ctx.toml_spec();
 
-    auto str = reg.as_string();
+    using string_type = typename basic_value<TC>::string_type;
+    using char_type   = typename string_type::value_type;
+    static_assert(sizeof(char_type) == 1, "toml::parse: the spans of the "
+        "source are copied into string_type as-is; its value_type must be a "
+        "single byte.");
 
-    // we already checked that it starts with """ and ends with """.
-    assert(str.substr(0, 3) == "\"\"\"");
-    str.erase(0, 3);
+    string_format_info fmt;
+    fmt.fmt = string_format::multiline_basic;
 
-    assert(str.size() >= 3);
-    assert(str.substr(str.size()-3, 3) == "\"\"\"");
-    str.erase(str.size()-3, 3);
+    const auto src  = loc.source()->data();
+    const auto open = src + loc.get_location();
+    const auto eof  = src + loc.source()->size();
 
     // the first newline just after """ is trimmed
-    if(str.size() >= 1 && str.at(0) == '\n')
+    const auto body_first = [&fmt, eof](location::char_type const* p)
+        -> location::char_type const*
     {
-        str.erase(0, 1);
-        fmt.start_with_newline = true;
-    }
-    else if(str.size() >= 2 && str.at(0) == '\r' && str.at(1) == '\n')
-    {
-        str.erase(0, 2);
-        fmt.start_with_newline = true;
-    }
+        if(p != eof && *p == '\n')
+        {
+            fmt.start_with_newline = true;
+            return p + 1;
+        }
+        else if(eof - p >= 2 && p[0] == '\r' && p[1] == '\n')
+        {
+            fmt.start_with_newline = true;
+            return p + 2;
+        }
+        return p;
+    };
 
-    using string_type = typename basic_value<TC>::string_type;
-    string_type val;
+    // ----------------------------------------------------------------------
+    // fast path: if there is no escape sequence, find the closing """ and
+    // copy the body at once without running the scanner.
+
+    if(eof - open >= 3 && open[0] == '"' && open[1] == '"' && open[2] == '"')
     {
-        auto iter = str.cbegin();
-        while(iter != str.cend())
+        const auto body = body_first(open + 3);
+        auto iter = body;
+        while(true)
         {
-            if(*iter == '\\') // remove whitespaces around escaped-newline
+            iter = find_basic_string_special(iter, eof);
+            if(iter == eof)
+            {
+                break;
+            }
+            else if(*iter == '\n')
+            {
+                iter += 1;
+            }
+            else if(*iter == '\r' && eof - iter >= 2 && iter[1] == '\n')
+            {
+                iter += 2;
+            }
+            else if(*iter == '"')
             {
-                // we assume that the string is not too long to copy
-                auto loc2 = make_temporary_location(make_string(iter, str.cend()));
-                if(syntax::escaped_newline(spec).scan(loc2).is_ok())
+                // """ closes the string. up to two more quotes belong to the
+                // body, like `"""a"""""` == "a\"\"".
+                std::size_t n = 1;
+                while(n < 5 && eof - iter > static_cast<std::ptrdiff_t>(n) && iter[n] == '"')
                 {
-                    std::advance(iter, loc2.get_location()); // skip escaped newline and indent
-                    // now iter points non-WS char
-                    assert(iter == str.end() || (*iter != ' ' && *iter != '\t'));
+                    ++n;
                 }
-                else // normal escape seq.
+                if(n < 3)
                 {
-                    auto esc = parse_escape_sequence(loc2, ctx);
-
-                    // syntax does not check its value. the unicode codepoint may be
-                    // invalid, e.g. out-of-bound, [0xD800, 0xDFFF]
-                    if(esc.is_err())
-                    {
-                        return err(esc.unwrap_err());
-                    }
-
-                    val += esc.unwrap();
-                    std::advance(iter, loc2.get_location());
+                    iter += n;
+                    continue;
                 }
+                const auto close = iter + (n - 3);
+                string_type val(reinterpret_cast<const char_type*>(body),
+                                static_cast<std::size_t>(close - body));
+
+                loc.advance(static_cast<std::size_t>(iter + n - open));
+                return ok(basic_value<TC>(
+                        std::move(val), std::move(fmt), {}, make_value_region<TC>(first, loc)
+                    ));
             }
-            else // we already checked the syntax. we don't need to check it again.
+            else // an escape sequence or an invalid character
             {
-                val += static_cast<typename string_type::value_type>(*iter);
-                ++iter;
+                break;
             }
         }
+        fmt.start_with_newline = false;
     }
 
-    return ok(basic_value<TC>(
-            std::move(val), std::move(fmt), {}, std::move(reg)
-        ));
-}
-
-template<typename TC>
-result<std::pair<typename basic_value<TC>::string_type, region>, error_info>
-parse_basic_string_only(location& loc, const context<TC>& ctx)
-{
-    const auto first = loc;
-    const auto& spec = ctx.toml_spec();
-
-    auto reg = syntax::basic_string(spec).scan(loc);
+    auto reg = static_scan<static_syntax::ml_basic_string>(loc, spec);
     if( ! reg.is_ok())
     {
-        return err(make_syntax_error("toml::parse_basic_string: "
+        return err(make_syntax_error("toml::parse_ml_basic_string: "
             "invalid string format",
-            syntax::basic_string(spec), loc));
+            syntax::ml_basic_string(spec), loc));
     }
 
     // ----------------------------------------------------------------------
     // it matches. gen value
 
-    auto str = reg.as_string();
+    // we already checked that it starts with """ and ends with """.
+    assert(reg.length() >= 6);
+    const auto body = body_first(open + 3);
+    location body_loc(loc, first);
+    body_loc.advance(static_cast<std::size_t>(body - open));
 
-    assert(str.back() == '\"');
-    str.pop_back();
-    assert(str.at(0) == '\"');
-    str.erase(0, 1);
+    auto val = parse_basic_string_body(std::move(body_loc), src + loc.get_location() - 3, ctx, true);
+    if(val.is_err())
+    {
+        return err(val.unwrap_err());
+    }
 
-    using string_type = typename basic_value<TC>::string_type;
+    return ok(basic_value<TC>(
+            std::move(val.unwrap()), std::move(fmt), {}, std::move(reg)
+        ));
+}
+
+template<typename TC>
+result<std::pair<typename basic_value<TC>::string_type, region>, error_info>
+parse_basic_string_only(location& loc, const context<TC>& ctx)
+{
+    const auto first = loc.get_cursor();
+    const auto& spec = ctx.toml_spec();
+
+    using string_type = typename basic_value<TC>::string_type;
     using char_type   = typename string_type::value_type;
-    string_type val;
+    static_assert(sizeof(char_type) == 1, "toml::parse: the spans of the "
+        "source are copied into string_type as-is; its value_type must be a "
+        "single byte.");
 
+    const auto src  = loc.source()->data();
+    const auto open = src + loc.get_location();
+    const auto eof  = src + loc.source()->size();
+
+    // ----------------------------------------------------------------------
+    // fast path: if the first special character is the closing quote, there
+    // is no escape sequence. copy the body at once without running the scanner.
+
+    if(open != eof && *open == '"')
     {
-        auto iter = str.begin();
-        while(iter != str.end())
+        const auto close = find_basic_string_special(open + 1, eof);
+        if(close != eof && *close == '"')
         {
-            if(*iter == '\\')
-            {
-                auto loc2 = make_temporary_location(make_string(iter, str.end()));
+            string_type val(reinterpret_cast<const char_type*>(open + 1),
+                            static_cast<std::size_t>(close - open - 1));
+            loc.advance(static_cast<std::size_t>(close + 1 - open));
+            return ok(std::make_pair(std::move(val), region(first, loc)));
+        }
+    }
 
-                auto esc = parse_escape_sequence(loc2, ctx);
+    auto reg = static_scan<static_syntax::basic_string>(loc, spec);
+    if( ! reg.is_ok())
+    {
+        return err(make_syntax_error("toml::parse_basic_string: "
+            "invalid string format",
+            syntax::basic_string(spec), loc));
+    }
 
-                // syntax does not check its value. the unicode codepoint may be
-                // invalid, e.g. out-of-bound, [0xD800, 0xDFFF]
-                if(esc.is_err())
-                {
-                    return err(esc.unwrap_err());
-                }
+    // ----------------------------------------------------------------------
+    // it matches. gen value
 
-                val += esc.unwrap();
-                std::advance(iter, loc2.get_location());
-            }
-            else
-            {
-                val += char_type(*iter); // we already checked the syntax.
-                ++iter;
-            }
-        }
+    location body_loc(loc, first);
+    body_loc.advance(); // skip "
+
+    auto val = parse_basic_string_body(std::move(body_loc), src + loc.get_location() - 1, ctx, false);
+    if(val.is_err())
+    {
+        return err(val.unwrap_err());
     }
-    return ok(std::make_pair(val, reg));
+    return ok(std::make_pair(std::move(val.unwrap()), std::move(reg)));
 }
 
 template<typename TC>
 result<basic_value<TC>, error_info>
 parse_basic_string(location& loc, const context<TC>& ctx)
 {
-    const auto first = loc;
-
     string_format_info fmt;
     fmt.fmt = string_format::basic;
 
@@ -1488,13 +1589,12 @@ template<typename TC>
 result<basic_value<TC>, error_info>
 parse_ml_literal_string(location& loc, const context<TC>& ctx)
 {
-    const auto first = loc;
     const auto& spec = ctx.toml_spec();
 
     string_format_info fmt;
     fmt.fmt = string_format::multiline_literal;
 
-    auto reg = syntax::ml_literal_string(spec).scan(loc);
+    auto reg = static_scan<static_syntax::ml_literal_string>(loc, spec);
     if( ! reg.is_ok())
     {
         return err(make_syntax_error("toml::parse_ml_literal_string: "
@@ -1505,27 +1605,26 @@ parse_ml_literal_string(location& loc, const context<TC>& ctx)
     // ----------------------------------------------------------------------
     // it matches. gen value
 
-    auto str = reg.as_string();
+    const auto str = reg.as_view();
 
     assert(str.substr(0, 3) == "'''");
     assert(str.substr(str.size()-3, 3) == "'''");
-    str.erase(0, 3);
-    str.erase(str.size()-3, 3);
+    auto body = str.substr(3, str.size() - 6);
 
     // the first newline just after """ is trimmed
-    if(str.size() >= 1 && str.at(0) == '\n')
+    if(body.size() >= 1 && body[0] == '\n')
     {
-        str.erase(0, 1);
+        body = body.substr(1);
         fmt.start_with_newline = true;
     }
-    else if(str.size() >= 2 && str.at(0) == '\r' && str.at(1) == '\n')
+    else if(body.size() >= 2 && body[0] == '\r' && body[1] == '\n')
     {
-        str.erase(0, 2);
+        body = body.substr(2);
         fmt.start_with_newline = true;
     }
 
     using string_type = typename basic_value<TC>::string_type;
-    string_type val(str.begin(), str.end());
+    auto val = body.template as_string<string_type>();
 
     return ok(basic_value<TC>(
             std::move(val), std::move(fmt), {}, std::move(reg)
@@ -1536,10 +1635,9 @@ template<typename TC>
 result<std::pair<typename basic_value<TC>::string_type, region>, error_info>
 parse_literal_string_only(location& loc, const context<TC>& ctx)
 {
-    const auto first = loc;
     const auto& spec = ctx.toml_spec();
 
-    auto reg = syntax::literal_string(spec).scan(loc);
+    auto reg = static_scan<static_syntax::literal_string>(loc, spec);
     if( ! reg.is_ok())
     {
         return err(make_syntax_error("toml::parse_literal_string: "
@@ -1550,15 +1648,13 @@ parse_literal_string_only(location& loc, const context<TC>& ctx)
     // ----------------------------------------------------------------------
     // it matches. gen value
 
-    auto str = reg.as_string();
+    const auto str = reg.as_view();
 
-    assert(str.back() == '\'');
-    str.pop_back();
-    assert(str.at(0) == '\'');
-    str.erase(0, 1);
+    assert(str.front() == '\'');
+    assert(str.back()  == '\'');
 
     using string_type = typename basic_value<TC>::string_type;
-    string_type val(str.begin(), str.end());
+    auto val = str.substr(1, str.size() - 2).template as_string<string_type>();
 
     return ok(std::make_pair(std::move(val), std::move(reg)));
 }
@@ -1567,8 +1663,6 @@ template<typename TC>
 result<basic_value<TC>, error_info>
 parse_literal_string(location& loc, const context<TC>& ctx)
 {
-    const auto first = loc;
-
     string_format_info fmt;
     fmt.fmt = string_format::literal;
 
@@ -1589,31 +1683,31 @@ template<typename TC>
 result<basic_value<TC>, error_info>
 parse_string(location& loc, const context<TC>& ctx)
 {
-    const auto first = loc;
+    const auto first = loc.get_cursor();
 
     if( ! loc.eof() && loc.current() == '"')
     {
-        if(literal("\"\"\"").scan(loc).is_ok())
+        if(static_skip<static_scanner::literal<'"', '"', '"'>>(loc, ctx.toml_spec()))
         {
-            loc = first;
+            loc.reset(first);
             return parse_ml_basic_string(loc, ctx);
         }
         else
         {
-            loc = first;
+            loc.reset(first);
             return parse_basic_string(loc, ctx);
         }
     }
     else if( ! loc.eof() && loc.current() == '\'')
     {
-        if(literal("'''").scan(loc).is_ok())
+        if(static_skip<static_scanner::literal<'\'', '\'', '\''>>(loc, ctx.toml_spec()))
         {
-            loc = first;
+            loc.reset(first);
             return parse_ml_literal_string(loc, ctx);
         }
         else
         {
-            loc = first;
+            loc.reset(first);
             return parse_literal_string(loc, ctx);
         }
     }
@@ -1639,7 +1733,7 @@ parse_null(location& loc, const context<TC>& ctx)
 
     // ----------------------------------------------------------------------
     // check syntax
-    auto reg = syntax::null_value(spec).scan(loc);
+    auto reg = static_scan<static_syntax::null_value>(loc, spec);
     if( ! reg.is_ok())
     {
         return err(make_syntax_error("toml::parse_null: "
@@ -1699,9 +1793,9 @@ parse_simple_key(location& loc, const context<TC>& ctx)
 
     // bare key.
 
-    if(const auto bare = syntax::unquoted_key(spec).scan(loc))
+    if(const auto bare = static_scan<static_syntax::unquoted_key>(loc, spec))
     {
-        return ok(string_conv<key_type>(bare.as_string()));
+        return ok(bare.as_view().template as_string<key_type>());
     }
     else
     {
@@ -1725,7 +1819,7 @@ template<typename TC>
 result<std::pair<std::vector<typename basic_value<TC>::key_type>, region>, error_info>
 parse_key(location& loc, const context<TC>& ctx)
 {
-    const auto first = loc;
+    const auto first = loc.get_cursor();
     const auto& spec = ctx.toml_spec();
 
     using key_type = typename basic_value<TC>::key_type;
@@ -1739,7 +1833,7 @@ parse_key(location& loc, const context<TC>& ctx)
         }
         keys.push_back(std::move(key.unwrap()));
 
-        auto reg = syntax::dot_sep(spec).scan(loc);
+        auto reg = static_scan<static_syntax::dot_sep>(loc, spec);
         if( ! reg.is_ok())
         {
             break;
@@ -1747,7 +1841,7 @@ parse_key(location& loc, const context<TC>& ctx)
     }
     if(keys.empty())
     {
-        auto src = source_location(region(first));
+        auto src = source_location(region(location(loc, first)));
         return err(make_error_info("toml::parse_key: expected a new key, "
                     "but got nothing", std::move(src), "reached EOF"));
     }
@@ -1769,28 +1863,28 @@ result<std::pair<
     >, error_info>
 parse_key_value_pair(location& loc, context<TC>& ctx)
 {
-    const auto first = loc;
+    const auto first = loc.get_cursor();
     const auto& spec = ctx.toml_spec();
 
     auto key_res = parse_key(loc, ctx);
     if(key_res.is_err())
     {
-        loc = first;
+        loc.reset(first);
         return err(key_res.unwrap_err());
     }
 
-    if( ! syntax::keyval_sep(spec).scan(loc).is_ok())
+    if( ! static_skip<static_syntax::keyval_sep>(loc, spec))
     {
         auto e = make_syntax_error("toml::parse_key_value_pair: "
             "invalid key value separator `=`", syntax::keyval_sep(spec), loc);
-        loc = first;
+        loc.reset(first);
         return err(std::move(e));
     }
 
     auto v_res = parse_value(loc, ctx);
     if(v_res.is_err())
     {
-        // loc = first;
+        // loc.reset(first);
         return err(v_res.unwrap_err());
     }
     return ok(std::make_pair(std::move(key_res.unwrap()), std::move(v_res.unwrap())));
@@ -1845,25 +1939,24 @@ skip_multiline_spacer(location& loc, context<TC>& ctx, const bool newline_found
     bool spacer_found = false;
     while( ! loc.eof())
     {
-        if(auto comm = sequence(syntax::comment(spec), syntax::newline(spec)).scan(loc))
+        // a comment must be followed by a newline or EOF
+        const auto first = loc.get_cursor();
+        auto comm = static_scan<static_syntax::comment>(loc, spec);
+        if(comm.is_ok() && ! loc.eof() && ! static_skip<static_syntax::newline>(loc, spec))
         {
-            spacer.newline_found = true;
-            auto comment = comm.as_string();
-            if( ! comment.empty() && comment.back() == '\n')
-            {
-                comment.pop_back();
-                if (!comment.empty() && comment.back() == '\r')
-                {
-                    comment.pop_back();
-                }
-            }
+            loc.reset(first);
+            comm = region{};
+        }
 
-            spacer.comments.push_back(std::move(comment));
+        if(comm.is_ok())
+        {
+            spacer.newline_found = true;
+            push_comment(spacer.comments, comm);
             spacer.indent_type = indent_char::none;
             spacer.indent = 0;
             spacer_found = true;
         }
-        else if(auto nl = syntax::newline(spec).scan(loc))
+        else if(auto nl = static_scan<static_syntax::newline>(loc, spec))
         {
             spacer.newline_found = true;
             spacer.comments.clear();
@@ -1871,13 +1964,13 @@ skip_multiline_spacer(location& loc, context<TC>& ctx, const bool newline_found
             spacer.indent = 0;
             spacer_found = true;
         }
-        else if(auto sp = repeat_at_least(1, character(cxx::bit_cast<location::char_type>(' '))).scan(loc))
+        else if(auto sp = static_scan<static_scanner::repeat_at_least<1, static_scanner::character<' '>>>(loc, spec))
         {
             spacer.indent_type = indent_char::space;
             spacer.indent      = static_cast<std::int32_t>(sp.length());
             spacer_found = true;
         }
-        else if(auto tabs = repeat_at_least(1, character(cxx::bit_cast<location::char_type>('\t'))).scan(loc))
+        else if(auto tabs = static_scan<static_scanner::repeat_at_least<1, static_scanner::character<'\t'>>>(loc, spec))
         {
             spacer.indent_type = indent_char::tab;
             spacer.indent      = static_cast<std::int32_t>(tabs.length());
@@ -1902,7 +1995,7 @@ parse_array(location& loc, context<TC>& ctx)
 {
     const auto num_errors = ctx.errors().size();
 
-    const auto first = loc;
+    const auto first = loc.get_cursor();
 
     if(loc.eof() || loc.current() != '[')
     {
@@ -1982,7 +2075,7 @@ parse_array(location& loc, context<TC>& ctx)
                 }
             }
 
-            comma_found = character(',').scan(loc).is_ok();
+            comma_found = static_skip<static_scanner::character<','>>(loc, ctx.toml_spec());
 
             // parse comment after a comma
             // array = [
@@ -2001,7 +2094,7 @@ parse_array(location& loc, context<TC>& ctx)
             if(comment_found)
             {
                 fmt.fmt = array_format::multiline;
-                elem.comments().push_back(com_res.unwrap().value());
+                push_comment(elem.comments(), com_res.unwrap().value());
             }
             if(comma_found)
             {
@@ -2049,7 +2142,7 @@ parse_array(location& loc, context<TC>& ctx)
     }
 
     return ok(basic_value<TC>(
-            std::move(val), std::move(fmt), {}, region(first, loc)
+            std::move(val), std::move(fmt), {}, make_value_region<TC>(first, loc)
         ));
 }
 
@@ -2162,8 +2255,6 @@ insert_value(const inserting_value_kind kind,
     using array_type = typename basic_value<TC>::array_type;
     using table_type = typename basic_value<TC>::table_type;
 
-    auto key_loc = source_location(key_reg);
-
     assert( ! keys.empty());
 
     // dotted key can insert to dotted key tables defined at the same level.
@@ -2219,7 +2310,7 @@ insert_value(const inserting_value_kind kind,
                     // foo = {bar = "baz"} or foo = { \n bar = "baz" \n }
                     return err(make_error_info("toml::insert_value: "
                         "failed to insert a value: inline table is immutable",
-                        key_loc, "inserting this",
+                        source_location(key_reg), "inserting this",
                         found->second.location(), "to this table"));
                 }
                 // dotted key cannot reopen a table.
@@ -2227,7 +2318,7 @@ insert_value(const inserting_value_kind kind,
                 {
                     return err(make_error_info("toml::insert_value: "
                         "reopening a table using dotted keys",
-                        key_loc, "dotted key cannot reopen a table",
+                        source_location(key_reg), "dotted key cannot reopen a table",
                         found->second.location(), "this table is already closed"));
                 }
                 assert(found->second.is_table());
@@ -2240,7 +2331,7 @@ insert_value(const inserting_value_kind kind,
                 {
                     return err(make_error_info("toml::insert_value:"
                         "inline array of tables are immutable",
-                        key_loc, "inserting this",
+                        source_location(key_reg), "inserting this",
                         found->second.location(), "inline array of tables"));
                 }
                 // appending to [[aot]]
@@ -2252,7 +2343,7 @@ insert_value(const inserting_value_kind kind,
                     // tables.x = "foo"    # appending `x` to the first table
                     return err(make_error_info("toml::insert_value:"
                         "dotted key cannot reopen an array-of-tables",
-                        key_loc, "inserting this",
+                        source_location(key_reg), "inserting this",
                         found->second.location(), "to this array-of-tables."));
                 }
 
@@ -2272,7 +2363,7 @@ insert_value(const inserting_value_kind kind,
             {
                 return err(make_error_info("toml::insert_value: "
                     "failed to insert a value, value already exists",
-                    key_loc, "while inserting this",
+                    source_location(key_reg), "while inserting this",
                     found->second.location(), "non-table value already exists"));
             }
         }
@@ -2286,7 +2377,7 @@ insert_value(const inserting_value_kind kind,
                     {
                         return err(make_error_info("toml::insert_value: "
                             "failed to insert a value, value already exists",
-                            key_loc, "inserting this",
+                            source_location(key_reg), "inserting this",
                             current_table.at(key).location(), "but value already exists"));
                     }
                     current_table.emplace(key, std::move(val));
@@ -2310,7 +2401,7 @@ insert_value(const inserting_value_kind kind,
                         {
                             return err(make_error_info("toml::insert_value: "
                                 "failed to insert a table, table already defined",
-                                key_loc, "inserting this",
+                                source_location(key_reg), "inserting this",
                                 target.location(), "this table is explicitly defined"));
                         }
 
@@ -2325,7 +2416,7 @@ insert_value(const inserting_value_kind kind,
                                 // y = "bar"
                                 return err(make_error_info("toml::insert_value: "
                                     "failed to insert a table, table keys conflict to each other",
-                                    key_loc, "inserting this table",
+                                    source_location(key_reg), "inserting this table",
                                     kv.second.location(), "having this value",
                                     target.at(kv.first).location(), "already defined here"));
                             }
@@ -2365,14 +2456,14 @@ insert_value(const inserting_value_kind kind,
                         {
                             return err(make_error_info("toml::insert_value: "
                                 "failed to insert an array of tables, value already exists",
-                                key_loc, "while inserting this",
+                                source_location(key_reg), "while inserting this",
                                 found->second.location(), "non-table value already exists"));
                         }
                         if(found->second.as_array_fmt().fmt != array_format::array_of_tables)
                         {
                             return err(make_error_info("toml::insert_value: "
                                 "failed to insert a table, inline array of tables is immutable",
-                                key_loc, "while inserting this",
+                                source_location(key_reg), "while inserting this",
                                 found->second.location(), "this is inline array-of-tables"));
                         }
                         found->second.as_array().push_back(std::move(val));
@@ -2385,7 +2476,7 @@ insert_value(const inserting_value_kind kind,
         }
     }
     return err(make_error_info("toml::insert_key: no keys found",
-                std::move(key_loc), "here"));
+                source_location(key_reg), "here"));
 }
 
 // ----------------------------------------------------------------------------
@@ -2398,7 +2489,7 @@ parse_inline_table(location& loc, context<TC>& ctx)
 
     const auto num_errors = ctx.errors().size();
 
-    const auto first = loc;
+    const auto first = loc.get_cursor();
     const auto& spec = ctx.toml_spec();
 
     if(loc.eof() || loc.current() != '{')
@@ -2536,7 +2627,7 @@ parse_inline_table(location& loc, context<TC>& ctx)
                 skip_whitespace(loc, ctx);
             }
 
-            comma_found = character(',').scan(loc).is_ok();
+            comma_found = static_skip<static_scanner::character<','>>(loc, spec);
 
             if(spec.v1_1_0_allow_newlines_in_inline_tables)
             {
@@ -2549,7 +2640,7 @@ parse_inline_table(location& loc, context<TC>& ctx)
                 if(comment_found)
                 {
                     fmt.fmt = table_format::multiline_oneline;
-                    ins_res.unwrap()->comments().push_back(com_res.unwrap().value());
+                    push_comment(ins_res.unwrap()->comments(), com_res.unwrap().value());
                 }
                 if(comma_found)
                 {
@@ -2604,7 +2695,7 @@ parse_inline_table(location& loc, context<TC>& ctx)
     }
 
     basic_value<TC> retval(
-        std::move(table), std::move(fmt), {}, region(first, loc));
+        std::move(table), std::move(fmt), {}, make_value_region<TC>(first, loc));
 
     return ok(std::move(retval));
 }
@@ -2623,13 +2714,13 @@ guess_number_type(const location& first, const context<TC>& ctx)
     const auto& spec = ctx.toml_spec();
     location loc = first;
 
-    if(syntax::offset_datetime(spec).scan(loc).is_ok())
+    if(static_skip<static_syntax::offset_datetime>(loc, spec))
     {
         return ok(value_t::offset_datetime);
     }
     loc = first;
 
-    if(syntax::local_datetime(spec).scan(loc).is_ok())
+    if(static_skip<static_syntax::local_datetime>(loc, spec))
     {
         const auto curr = loc.current();
         // if offset_datetime contains bad offset, it syntax::offset_datetime
@@ -2645,7 +2736,7 @@ guess_number_type(const location& first, const context<TC>& ctx)
     }
     loc = first;
 
-    if(syntax::local_date(spec).scan(loc).is_ok())
+    if(static_skip<static_syntax::local_date>(loc, spec))
     {
         // bad time may appear after this.
 
@@ -2688,17 +2779,17 @@ guess_number_type(const location& first, const context<TC>& ctx)
     }
     loc = first;
 
-    if(syntax::local_time(spec).scan(loc).is_ok())
+    if(static_skip<static_syntax::local_time>(loc, spec))
     {
         return ok(value_t::local_time);
     }
     loc = first;
 
-    if(syntax::floating(spec).scan(loc).is_ok())
+    if(static_skip<static_syntax::floating>(loc, spec))
     {
         if( ! loc.eof() && loc.current() == '_')
         {
-            if(spec.ext_num_suffix && syntax::num_suffix(spec).scan(loc).is_ok())
+            if(spec.ext_num_suffix && static_skip<static_syntax::num_suffix>(loc, spec))
             {
                 return ok(value_t::floating);
             }
@@ -2715,11 +2806,11 @@ guess_number_type(const location& first, const context<TC>& ctx)
 
     if(spec.ext_hex_float)
     {
-        if(syntax::hex_floating(spec).scan(loc).is_ok())
+        if(static_skip<static_syntax::hex_floating>(loc, spec))
         {
             if( ! loc.eof() && loc.current() == '_')
             {
-                if(spec.ext_num_suffix && syntax::num_suffix(spec).scan(loc).is_ok())
+                if(spec.ext_num_suffix && static_skip<static_syntax::num_suffix>(loc, spec))
                 {
                     return ok(value_t::floating);
                 }
@@ -2735,20 +2826,20 @@ guess_number_type(const location& first, const context<TC>& ctx)
         loc = first;
     }
 
-    if(auto int_reg = syntax::integer(spec).scan(loc))
+    if(auto int_reg = static_scan<static_syntax::integer>(loc, spec))
     {
         if( ! loc.eof())
         {
             const auto c = loc.current();
             if(c == '_')
             {
-                if(spec.ext_num_suffix && syntax::num_suffix(spec).scan(loc).is_ok())
+                if(spec.ext_num_suffix && static_skip<static_syntax::num_suffix>(loc, spec))
                 {
                     return ok(value_t::integer);
                 }
 
-                if(int_reg.length() <= 2 && (int_reg.as_string() == "0" ||
-                    int_reg.as_string() == "-0" || int_reg.as_string() == "+0"))
+                const auto int_str = int_reg.as_view();
+                if(int_str == "0" || int_str == "-0" || int_str == "+0")
                 {
                     auto src = source_location(region(loc));
                     return err(make_error_info(
@@ -2870,7 +2961,7 @@ guess_value_type(const location& loc, const context<TC>& ctx)
         }
         case 'i' : // inf or string without quotes(syntax error).
         {
-            if(literal("inf").scan(inner).is_ok())
+            if(static_skip<static_scanner::literal<'i', 'n', 'f'>>(inner, sp))
             {
                 return ok(value_t::floating);
             }
@@ -2893,11 +2984,11 @@ guess_value_type(const location& loc, const context<TC>& ctx)
         {
             if(sp.ext_null_value)
             {
-                if(literal("nan").scan(inner).is_ok())
+                if(static_skip<static_scanner::literal<'n', 'a', 'n'>>(inner, sp))
                 {
                     return ok(value_t::floating);
                 }
-                else if(literal("null").scan(inner).is_ok())
+                else if(static_skip<static_scanner::literal<'n', 'u', 'l', 'l'>>(inner, sp))
                 {
                     return ok(value_t::empty);
                 }
@@ -2911,7 +3002,7 @@ guess_value_type(const location& loc, const context<TC>& ctx)
             }
             else // must be nan.
             {
-                if(literal("nan").scan(inner).is_ok())
+                if(static_skip<static_scanner::literal<'n', 'a', 'n'>>(inner, sp))
                 {
                     return ok(value_t::floating);
                 }
@@ -2948,10 +3039,191 @@ guess_value_type(const location& loc, const context<TC>& ctx)
     }
 }
 
+// ----------------------------------------------------------------------------
+// Classifies a number or a datetime in a single forward pass.
+//
+// guess_number_type tries the syntax of each type in turn, scanning the same
+// bytes several times. Instead, this reads the token once and looks at its
+// shape (`YYYY-`, `HH:`, `0x`, `.`, `e`, ...) without checking the syntax
+// strictly. The type is confirmed by the parse_* function of that type: if it
+// fails, or it does not consume the whole token, parse_value falls back to
+// guess_number_type, which generates the detailed error messages.
+
+struct number_token
+{
+    value_t     type; // value_t::empty if it cannot be determined
+    std::size_t last; // position of the end of the token
+};
+
+inline bool is_number_token_char(const location::char_type c) noexcept
+{
+    return ('0' <= c && c <= '9') || ('a' <= c && c <= 'z') ||
+           ('A' <= c && c <= 'Z') || c == '+' || c == '-' || c == '.' ||
+           c == '_' || c == ':' || 0x80 <= c; // 0x80 <= c: number suffix
+}
+
+template<typename TC>
+number_token lex_number_type(const location& loc, const context<TC>& ctx)
+{
+    using char_type = location::char_type;
+    const auto& spec = ctx.toml_spec();
+
+    const auto& src   = *loc.source();
+    const auto  first = src.data() + loc.get_location();
+    const auto  last  = src.data() + src.size();
+
+    const auto is_digit = [](const char_type c) noexcept {
+        return '0' <= c && c <= '9';
+    };
+    const auto count_digits = [&is_digit](const char_type* iter, const char_type* end) noexcept {
+        std::size_t n = 0;
+        while(iter != end && is_digit(*iter)) {++iter; ++n;}
+        return n;
+    };
+
+    auto iter = first;
+    while(iter != last && is_number_token_char(*iter))
+    {
+        ++iter;
+    }
+    auto end = iter;
+    const auto len = static_cast<std::size_t>(end - first);
+
+    const auto token_of = [&](const value_t t) {
+        return number_token{t, loc.get_location() + static_cast<std::size_t>(end - first)};
+    };
+
+    const auto n_digits = count_digits(first, end);
+
+    // YYYY-MM-DD, YYYY-MM-DDTHH:MM:SS, YYYY-MM-DD HH:MM:SS(+offset)
+    if(n_digits == 4 && len > 4 && first[4] == '-')
+    {
+        if(len == 10)
+        {
+            // a space is allowed as a delimiter between date and time
+            if(end + 1 < last && *end == ' ' && is_digit(*(end + 1)))
+            {
+                ++end;
+                while(end != last && is_number_token_char(*end))
+                {
+                    ++end;
+                }
+            }
+            else
+            {
+                return token_of(value_t::local_date);
+            }
+        }
+        if(static_cast<std::size_t>(end - first) <= 11)
+        {
+            return token_of(value_t::empty);
+        }
+        // the first character of time offset, after HH:MM:SS(.subsec)
+        const auto off = std::find_if(first + 11, end, [&is_digit](const char_type c) {
+                return ! is_digit(c) && c != ':' && c != '.';
+            });
+        return token_of(off == end ? value_t::local_datetime : value_t::offset_datetime);
+    }
+    // HH:MM:SS
+    if(n_digits == 2 && len > 2 && first[2] == ':')
+    {
+        return token_of(value_t::local_time);
+    }
+
+    auto p = first;
+    if(p != end && (*p == '+' || *p == '-'))
+    {
+        ++p;
+    }
+    if(p == end)
+    {
+        return token_of(value_t::empty);
+    }
+    if(*p == 'i' || *p == 'n') // +inf, -nan, ...
+    {
+        const auto rest = end - p;
+        if(rest >= 3 && ((p[0] == 'i' && p[1] == 'n' && p[2] == 'f') ||
+                         (p[0] == 'n' && p[1] == 'a' && p[2] == 'n')))
+        {
+            return token_of(value_t::floating);
+        }
+        return token_of(value_t::empty);
+    }
+
+    if(*p == '0' && p + 1 != end && (p[1] == 'x' || p[1] == 'o' || p[1] == 'b'))
+    {
+        if(p[1] == 'x' && spec.ext_hex_float && std::find_if(p + 2, end,
+            [](const char_type c) {return c == '.' || c == 'p' || c == 'P';}) != end)
+        {
+            return token_of(value_t::floating);
+        }
+        return token_of(value_t::integer);
+    }
+
+    // a leading zero, like `01.5`, is not allowed.
+    if(*p == '0' && p + 1 != end && (is_digit(p[1]) || p[1] == '_'))
+    {
+        return token_of(value_t::empty);
+    }
+
+    // the first character after decimal digits and `_` between digits.
+    // `1.0`, `1e3`, `1_000.0`, `1_000_μm`
+    while(p != end && (is_digit(*p) ||
+                       (*p == '_' && p + 1 != end && is_digit(p[1]))))
+    {
+        ++p;
+    }
+    if(p != end && (*p == '.' || *p == 'e' || *p == 'E'))
+    {
+        // a fraction or an exponent must have digits, like `1.0` or `1e+3`.
+        // Otherwise it is left to guess_number_type, which reports it.
+        auto q = p + 1;
+        if(*p != '.' && q != end && (*q == '+' || *q == '-'))
+        {
+            ++q;
+        }
+        if(q == end || ! is_digit(*q))
+        {
+            return token_of(value_t::empty);
+        }
+        return token_of(value_t::floating);
+    }
+    return token_of(value_t::integer);
+}
+
 template<typename TC>
 result<basic_value<TC>, error_info>
 parse_value(location& loc, context<TC>& ctx)
 {
+    if( ! loc.eof())
+    {
+        const auto c = loc.current();
+        if(('0' <= c && c <= '9') || c == '+' || c == '-')
+        {
+            const auto tk = lex_number_type(loc, ctx);
+            if(tk.type != value_t::empty)
+            {
+                const auto first = loc.get_cursor();
+                auto res = [&]() -> result<basic_value<TC>, error_info> {
+                    switch(tk.type)
+                    {
+                        case value_t::integer        : {return parse_integer        (loc, ctx);}
+                        case value_t::floating       : {return parse_floating       (loc, ctx);}
+                        case value_t::offset_datetime: {return parse_offset_datetime(loc, ctx);}
+                        case value_t::local_datetime : {return parse_local_datetime (loc, ctx);}
+                        case value_t::local_date     : {return parse_local_date     (loc, ctx);}
+                        default                      : {return parse_local_time     (loc, ctx);}
+                    }
+                }();
+                if(res.is_ok() && loc.get_location() == tk.last)
+                {
+                    return res;
+                }
+                loc.reset(first); // fallback to guess_number_type
+            }
+        }
+    }
+
     const auto ty_res = guess_value_type(loc, ctx);
     if(ty_res.is_err())
     {
@@ -3003,17 +3275,17 @@ template<typename TC>
 result<std::pair<std::vector<typename basic_value<TC>::key_type>, region>, error_info>
 parse_table_key(location& loc, context<TC>& ctx)
 {
-    const auto first = loc;
+    const auto first = loc.get_cursor();
     const auto& spec = ctx.toml_spec();
 
-    auto reg = syntax::std_table(spec).scan(loc);
+    auto reg = static_scan<static_syntax::std_table>(loc, spec);
     if(!reg.is_ok())
     {
         return err(make_syntax_error("toml::parse_table_key: invalid table key",
             syntax::std_table(spec), loc));
     }
 
-    loc = first;
+    loc.reset(first);
     loc.advance(); // skip [
     skip_whitespace(loc, ctx);
 
@@ -3033,17 +3305,17 @@ template<typename TC>
 result<std::pair<std::vector<typename basic_value<TC>::key_type>, region>, error_info>
 parse_array_table_key(location& loc, context<TC>& ctx)
 {
-    const auto first = loc;
+    const auto first = loc.get_cursor();
     const auto& spec = ctx.toml_spec();
 
-    auto reg = syntax::array_table(spec).scan(loc);
+    auto reg = static_scan<static_syntax::array_table>(loc, spec);
     if(!reg.is_ok())
     {
         return err(make_syntax_error("toml::parse_array_table_key: invalid array-of-tables key",
             syntax::array_table(spec), loc));
     }
 
-    loc = first;
+    loc.reset(first);
     loc.advance(); // [
     loc.advance(); // [
     skip_whitespace(loc, ctx);
@@ -3079,7 +3351,7 @@ parse_table(location& loc, context<TC>& ctx, basic_value<TC>& table)
     bool newline_found = true;
     while( ! loc.eof())
     {
-        const auto start = loc;
+        const auto start = loc.get_cursor();
 
         auto sp = skip_multiline_spacer(loc, ctx, newline_found);
 
@@ -3089,9 +3361,9 @@ parse_table(location& loc, context<TC>& ctx, basic_value<TC>& table)
             break;
         }
         // if next table is comming, return.
-        if(sequence(syntax::ws(spec), character('[')).scan(loc).is_ok())
+        if(static_skip<static_scanner::sequence<static_syntax::ws, static_scanner::character<'['>>>(loc, spec))
         {
-            loc = start;
+            loc.reset(start);
             break;
         }
         // otherwise, it should be a key-value pair.
@@ -3127,7 +3399,7 @@ parse_table(location& loc, context<TC>& ctx, basic_value<TC>& table)
             {
                 if(auto com_opt = com_res.unwrap())
                 {
-                    val.comments().push_back(com_opt.value());
+                    push_comment(val.comments(), com_opt.value());
                     newline_found = true; // comment includes newline at the end
                 }
             }
@@ -3166,7 +3438,7 @@ parse_file(location& loc, context<TC>& ctx)
     using value_type = basic_value<TC>;
     using table_type = typename value_type::table_type;
 
-    const auto first = loc;
+    const auto first = loc.get_cursor();
     const auto& spec = ctx.toml_spec();
 
     if(loc.eof())
@@ -3196,14 +3468,14 @@ parse_file(location& loc, context<TC>& ctx)
         {
             if(auto com_opt = com_res.unwrap())
             {
-                root.comments().push_back(std::move(com_opt.value()));
+                push_comment(root.comments(), com_opt.value());
             }
             else // no comment found.
             {
                 // if it is not an empty line, clear the root comment.
-                if( ! sequence(syntax::ws(spec), syntax::newline(spec)).scan(loc).is_ok())
+                if( ! static_skip<static_scanner::sequence<static_syntax::ws, static_syntax::newline>>(loc, spec))
                 {
-                    loc = first;
+                    loc.reset(first);
                     root.comments().clear();
                 }
                 break;
@@ -3232,105 +3504,105 @@ parse_file(location& loc, context<TC>& ctx)
     {
         auto sp = skip_multiline_spacer(loc, ctx, /*newline_found=*/true);
 
-        if(auto key_res = parse_array_table_key(loc, ctx))
+        // `[x]` is much more common. check `[[` first not to make an error.
+        if(static_scan_length<static_scanner::literal<'[', '['>>(loc, ctx.toml_spec())
+            != static_cast<std::size_t>(-1))
         {
-            auto key = std::move(std::get<0>(key_res.unwrap()));
-            auto reg = std::move(std::get<1>(key_res.unwrap()));
-
-            std::vector<std::string> com;
-            if(sp.has_value())
+            if(auto key_res = parse_array_table_key(loc, ctx))
             {
-                for(std::size_t i=0; i<sp.value().comments.size(); ++i)
+                auto key = std::move(std::get<0>(key_res.unwrap()));
+                auto reg = std::move(std::get<1>(key_res.unwrap()));
+
+                typename TC::comment_type com;
+                if(sp.has_value())
                 {
-                    com.push_back(std::move(sp.value().comments.at(i)));
+                    com = std::move(sp.value().comments);
                 }
-            }
 
-            // [table.def] must be followed by one of
-            // - a comment line
-            // - whitespace + newline
-            // - EOF
-            if(auto com_res = parse_comment_line(loc, ctx))
-            {
-                if(auto com_opt = com_res.unwrap())
+                // [table.def] must be followed by one of
+                // - a comment line
+                // - whitespace + newline
+                // - EOF
+                if(auto com_res = parse_comment_line(loc, ctx))
                 {
-                    com.push_back(com_opt.value());
+                    if(auto com_opt = com_res.unwrap())
+                    {
+                        push_comment(com, com_opt.value());
+                    }
+                    else // if there is no comment, ws+newline must exist (or EOF)
+                    {
+                        skip_whitespace(loc, ctx);
+                        if( ! loc.eof() && ! static_skip<static_syntax::newline>(loc, ctx.toml_spec()))
+                        {
+                            ctx.report_error(make_syntax_error("toml::parse_file: "
+                                "newline (or EOF) expected",
+                                syntax::newline(ctx.toml_spec()), loc));
+                            skip_until_next_table(loc, ctx);
+                            continue;
+                        }
+                    }
                 }
-                else // if there is no comment, ws+newline must exist (or EOF)
+                else // comment syntax error (rare)
                 {
-                    skip_whitespace(loc, ctx);
-                    if( ! loc.eof() && ! syntax::newline(ctx.toml_spec()).scan(loc).is_ok())
+                    ctx.report_error(com_res.unwrap_err());
+                    skip_until_next_table(loc, ctx);
+                    continue;
+                }
+
+                table_format_info fmt;
+                fmt.fmt = table_format::multiline;
+                fmt.indent_type = indent_char::none;
+                auto tab = value_type(table_type{}, std::move(fmt), {}, reg);
+                tab.comments() = std::move(com);
+
+                auto inserted = insert_value(inserting_value_kind::array_table,
+                    std::addressof(root.as_table()),
+                    key, std::move(reg), std::move(tab));
+
+                if(inserted.is_err())
+                {
+                    ctx.report_error(inserted.unwrap_err());
+
+                    // check errors in the table
+                    auto tmp = basic_value<TC>(table_type());
+                    auto res = parse_table(loc, ctx, tmp);
+                    if(res.is_err())
                     {
-                        ctx.report_error(make_syntax_error("toml::parse_file: "
-                            "newline (or EOF) expected",
-                            syntax::newline(ctx.toml_spec()), loc));
+                        ctx.report_error(res.unwrap_err());
                         skip_until_next_table(loc, ctx);
-                        continue;
                     }
+                    continue;
                 }
-            }
-            else // comment syntax error (rare)
-            {
-                ctx.report_error(com_res.unwrap_err());
-                skip_until_next_table(loc, ctx);
-                continue;
-            }
-
-            table_format_info fmt;
-            fmt.fmt = table_format::multiline;
-            fmt.indent_type = indent_char::none;
-            auto tab = value_type(table_type{}, std::move(fmt), std::move(com), reg);
-
-            auto inserted = insert_value(inserting_value_kind::array_table,
-                std::addressof(root.as_table()),
-                key, std::move(reg), std::move(tab));
 
-            if(inserted.is_err())
-            {
-                ctx.report_error(inserted.unwrap_err());
+                auto tab_ptr = inserted.unwrap();
+                assert(tab_ptr);
 
-                // check errors in the table
-                auto tmp = basic_value<TC>(table_type());
-                auto res = parse_table(loc, ctx, tmp);
-                if(res.is_err())
+                const auto tab_res = parse_table(loc, ctx, *tab_ptr);
+                if(tab_res.is_err())
                 {
-                    ctx.report_error(res.unwrap_err());
+                    ctx.report_error(tab_res.unwrap_err());
                     skip_until_next_table(loc, ctx);
                 }
-                continue;
-            }
-
-            auto tab_ptr = inserted.unwrap();
-            assert(tab_ptr);
 
-            const auto tab_res = parse_table(loc, ctx, *tab_ptr);
-            if(tab_res.is_err())
-            {
-                ctx.report_error(tab_res.unwrap_err());
-                skip_until_next_table(loc, ctx);
-            }
-
-            // parse_table first clears `indent_type`.
-            // to keep header indent info, we must store it later.
-            if(sp.has_value() && sp.value().indent_type != indent_char::none)
-            {
-                tab_ptr->as_table_fmt().indent_type = sp.value().indent_type;
-                tab_ptr->as_table_fmt().name_indent = sp.value().indent;
+                // parse_table first clears `indent_type`.
+                // to keep header indent info, we must store it later.
+                if(sp.has_value() && sp.value().indent_type != indent_char::none)
+                {
+                    tab_ptr->as_table_fmt().indent_type = sp.value().indent_type;
+                    tab_ptr->as_table_fmt().name_indent = sp.value().indent;
+                }
+                continue;
             }
-            continue;
         }
         if(auto key_res = parse_table_key(loc, ctx))
         {
             auto key = std::move(std::get<0>(key_res.unwrap()));
             auto reg = std::move(std::get<1>(key_res.unwrap()));
 
-            std::vector<std::string> com;
+            typename TC::comment_type com;
             if(sp.has_value())
             {
-                for(std::size_t i=0; i<sp.value().comments.size(); ++i)
-                {
-                    com.push_back(std::move(sp.value().comments.at(i)));
-                }
+                com = std::move(sp.value().comments);
             }
 
             // [table.def] must be followed by one of
@@ -3341,12 +3613,12 @@ parse_file(location& loc, context<TC>& ctx)
             {
                 if(auto com_opt = com_res.unwrap())
                 {
-                    com.push_back(com_opt.value());
+                    push_comment(com, com_opt.value());
                 }
                 else // if there is no comment, ws+newline must exist (or EOF)
                 {
                     skip_whitespace(loc, ctx);
-                    if( ! loc.eof() && ! syntax::newline(ctx.toml_spec()).scan(loc).is_ok())
+                    if( ! loc.eof() && ! static_skip<static_syntax::newline>(loc, ctx.toml_spec()))
                     {
                         ctx.report_error(make_syntax_error("toml::parse_file: "
                             "newline (or EOF) expected",
@@ -3366,7 +3638,8 @@ parse_file(location& loc, context<TC>& ctx)
             table_format_info fmt;
             fmt.fmt = table_format::multiline;
             fmt.indent_type = indent_char::none;
-            auto tab = value_type(table_type{}, std::move(fmt), std::move(com), reg);
+            auto tab = value_type(table_type{}, std::move(fmt), {}, reg);
+            tab.comments() = std::move(com);
 
             auto inserted = insert_value(inserting_value_kind::std_table,
                 std::addressof(root.as_table()),
@@ -3406,7 +3679,7 @@ parse_file(location& loc, context<TC>& ctx)
 
         // does not match array_table nor std_table. report an error.
         const auto keytop = loc;
-        const auto maybe_array_of_tables = literal("[[").scan(loc).is_ok();
+        const auto maybe_array_of_tables = static_skip<static_scanner::literal<'[', '['>>(loc, ctx.toml_spec());
         loc = keytop;
 
         if(maybe_array_of_tables)
@@ -3436,29 +3709,18 @@ parse_file(location& loc, context<TC>& ctx)
 
 template<typename TC>
 result<basic_value<TC>, std::vector<error_info>>
-parse_impl(std::vector<location::char_type> cs, std::string fname, const spec& s)
+parse_impl(location::source_ptr src, std::string fname, const spec& s)
 {
     using value_type = basic_value<TC>;
     using table_type = typename value_type::table_type;
 
     // an empty file is a valid toml file.
-    if(cs.empty())
+    if(src->empty())
     {
-        auto src = std::make_shared<std::vector<location::char_type>>(std::move(cs));
         location loc(std::move(src), std::move(fname));
         return ok(value_type(table_type(), table_format_info{}, std::vector<std::string>{}, region(loc)));
     }
 
-    // to simplify parser, add newline at the end if there is no LF.
-    // But, if it has raw CR, the file is invalid (in TOML, CR is not a valid
-    // newline char). if it ends with CR, do not add LF and report it.
-    if(cs.back() != '\n' && cs.back() != '\r')
-    {
-        cs.push_back('\n');
-    }
-
-    auto src = std::make_shared<std::vector<location::char_type>>(std::move(cs));
-
     location loc(std::move(src), std::move(fname));
 
     // skip BOM if found
@@ -3477,11 +3739,42 @@ parse_impl(std::vector<location::char_type> cs, std::string fname, const spec& s
         }
     }
 
+    const auto utf8 = validate_utf8(loc);
+    if(utf8.is_err())
+    {
+        return err(std::vector<error_info>{utf8.unwrap_err()});
+    }
+
     context<TC> ctx(s);
 
     return parse_file(loc, ctx);
 }
 
+template<typename TC>
+result<basic_value<TC>, std::vector<error_info>>
+parse_impl(std::vector<location::char_type> cs, std::string fname, const spec& s)
+{
+    return parse_impl<TC>(std::make_shared<const location::container_type>(
+            std::move(cs)), std::move(fname), s);
+}
+
+// returns the value, or throws syntax_error that has all the errors.
+template<typename TC>
+basic_value<TC>
+unwrap_or_throw(result<basic_value<TC>, std::vector<error_info>> res)
+{
+    if(res.is_ok())
+    {
+        return std::move(res.unwrap());
+    }
+    std::string msg;
+    for(const auto& err : res.unwrap_err())
+    {
+        msg += format_error(err);
+    }
+    throw syntax_error(std::move(msg), std::move(res.unwrap_err()));
+}
+
 } // detail
 
 // -----------------------------------------------------------------------------
@@ -3499,20 +3792,8 @@ basic_value<TC>
 parse(std::vector<unsigned char> content, std::string filename,
       spec s = spec::default_version())
 {
-    auto res = try_parse<TC>(std::move(content), std::move(filename), std::move(s));
-    if(res.is_ok())
-    {
-        return res.unwrap();
-    }
-    else
-    {
-        std::string msg;
-        for(const auto& err : res.unwrap_err())
-        {
-            msg += format_error(err);
-        }
-        throw syntax_error(std::move(msg), std::move(res.unwrap_err()));
-    }
+    return detail::unwrap_or_throw(try_parse<TC>(
+            std::move(content), std::move(filename), std::move(s)));
 }
 
 // -----------------------------------------------------------------------------
@@ -3522,37 +3803,28 @@ template<typename TC = type_config>
 result<basic_value<TC>, std::vector<error_info>>
 try_parse(std::istream& is, std::string fname = "unknown file", spec s = spec::default_version())
 {
-    const auto beg = is.tellg();
-    is.seekg(0, std::ios::end);
-    const auto end = is.tellg();
-    const auto fsize = end - beg;
-    is.seekg(beg);
-
-    // read whole file as a sequence of char
-    assert(fsize >= 0);
-    std::vector<detail::location::char_type> letters(static_cast<std::size_t>(fsize), '\0');
-    is.read(reinterpret_cast<char*>(letters.data()), static_cast<std::streamsize>(fsize));
-
-    return detail::parse_impl<TC>(std::move(letters), std::move(fname), std::move(s));
+    // read whole file as a sequence of char. the stream can be a pipe.
+    auto letters = detail::read_stream(is);
+    if(letters.is_err())
+    {
+        std::vector<error_info> e;
+        e.push_back(error_info("toml::parse: Error reading \"" + fname + "\"", {}));
+        return err(std::move(e));
+    }
+    return detail::parse_impl<TC>(std::move(letters.unwrap()), std::move(fname), std::move(s));
 }
 
 template<typename TC = type_config>
 basic_value<TC> parse(std::istream& is, std::string fname = "unknown file", spec s = spec::default_version())
 {
-    auto res = try_parse<TC>(is, std::move(fname), std::move(s));
-    if(res.is_ok())
+    auto letters = detail::read_stream(is);
+    if(letters.is_err())
     {
-        return res.unwrap();
-    }
-    else
-    {
-        std::string msg;
-        for(const auto& err : res.unwrap_err())
-        {
-            msg += format_error(err);
-        }
-        throw syntax_error(std::move(msg), std::move(res.unwrap_err()));
+        throw file_io_error("toml::parse: error reading stream", fname);
     }
+
+    return detail::unwrap_or_throw(detail::parse_impl<TC>(
+            std::move(letters.unwrap()), std::move(fname), std::move(s)));
 }
 
 // -----------------------------------------------------------------------------
@@ -3562,6 +3834,15 @@ template<typename TC = type_config>
 result<basic_value<TC>, std::vector<error_info>>
 try_parse(std::string fname, spec s = spec::default_version())
 {
+    if(s.memory_map_file)
+    {
+        // if it cannot be mapped (e.g. pipe), fall back to std::ifstream
+        if(auto src = detail::map_file(fname))
+        {
+            return detail::parse_impl<TC>(std::move(src), std::move(fname), std::move(s));
+        }
+    }
+
     std::ifstream ifs(fname, std::ios_base::binary);
     if(!ifs.good())
     {
@@ -3577,6 +3858,16 @@ try_parse(std::string fname, spec s = spec::default_version())
 template<typename TC = type_config>
 basic_value<TC> parse(std::string fname, spec s = spec::default_version())
 {
+    if(s.memory_map_file)
+    {
+        // if it cannot be mapped (e.g. pipe), fall back to std::ifstream
+        if(auto src = detail::map_file(fname))
+        {
+            return detail::unwrap_or_throw(detail::parse_impl<TC>(
+                    std::move(src), std::move(fname), std::move(s)));
+        }
+    }
+
     std::ifstream ifs(fname, std::ios_base::binary);
     if(!ifs.good())
     {
@@ -3608,31 +3899,81 @@ result<basic_value<TC>, std::vector<error_info>>
 try_parse_str(std::string content, spec s = spec::default_version(),
               cxx::source_location loc = cxx::source_location::current())
 {
-    std::istringstream iss(std::move(content));
+    // parse the string in place. it is kept alive by the source_buffer.
+    const auto str  = std::make_shared<const std::string>(std::move(content));
+    const auto data = reinterpret_cast<const detail::location::char_type*>(str->data());
+    auto src = std::make_shared<const detail::location::container_type>(data, str->size(), str);
+
     std::string name("internal string" + cxx::to_string(loc));
-    return try_parse<TC>(iss, std::move(name), std::move(s));
+    return detail::parse_impl<TC>(std::move(src), std::move(name), std::move(s));
 }
 
 template<typename TC = type_config>
 basic_value<TC> parse_str(std::string content, spec s = spec::default_version(),
         cxx::source_location loc = cxx::source_location::current())
 {
-    auto res = try_parse_str<TC>(std::move(content), std::move(s), std::move(loc));
+    return detail::unwrap_or_throw(try_parse_str<TC>(
+            std::move(content), std::move(s), std::move(loc)));
+}
+
+// ----------------------------------------------------------------------------
+// parse_view
+//
+// parses a buffer owned by the caller in place, without copying it.
+// Before returning, the values are detached from the buffer as
+// `detach_source(v, mode)` does. By default, the lines shown in error messages
+// are copied and the buffer needs to be alive only while parsing. With
+// `detach_mode::keep_source`, nothing is copied and the values refer to the
+// buffer, so it must outlive them.
+
+template<typename TC = type_config>
+result<basic_value<TC>, std::vector<error_info>>
+try_parse_view(const char* data, std::size_t size,
+               std::string fname = "unknown file", spec s = spec::default_version(),
+               detach_mode mode = detach_mode::keep_lines)
+{
+    auto src = std::make_shared<const detail::location::container_type>(
+            reinterpret_cast<const detail::location::char_type*>(data), size, nullptr);
+    auto res = detail::parse_impl<TC>(std::move(src), std::move(fname), std::move(s));
     if(res.is_ok())
     {
-        return res.unwrap();
-    }
-    else
-    {
-        std::string msg;
-        for(const auto& err : res.unwrap_err())
-        {
-            msg += format_error(err);
-        }
-        throw syntax_error(std::move(msg), std::move(res.unwrap_err()));
+        detach_source(res.unwrap(), mode);
     }
+    return res;
+}
+
+template<typename TC = type_config>
+basic_value<TC>
+parse_view(const char* data, std::size_t size,
+           std::string fname = "unknown file", spec s = spec::default_version(),
+           detach_mode mode = detach_mode::keep_lines)
+{
+    return detail::unwrap_or_throw(try_parse_view<TC>(
+            data, size, std::move(fname), std::move(s), mode));
+}
+
+#if defined(TOML11_HAS_STRING_VIEW)
+
+template<typename TC = type_config>
+result<basic_value<TC>, std::vector<error_info>>
+try_parse_view(std::string_view sv,
+               std::string fname = "unknown file", spec s = spec::default_version(),
+               detach_mode mode = detach_mode::keep_lines)
+{
+    return try_parse_view<TC>(sv.data(), sv.size(), std::move(fname), std::move(s), mode);
 }
 
+template<typename TC = type_config>
+basic_value<TC>
+parse_view(std::string_view sv,
+           std::string fname = "unknown file", spec s = spec::default_version(),
+           detach_mode mode = detach_mode::keep_lines)
+{
+    return parse_view<TC>(sv.data(), sv.size(), std::move(fname), std::move(s), mode);
+}
+
+#endif // TOML11_HAS_STRING_VIEW
+
 // ----------------------------------------------------------------------------
 // filesystem
 
@@ -3643,6 +3984,14 @@ cxx::enable_if_t<std::is_same<FSPATH, std::filesystem::path>::value,
     result<basic_value<TC>, std::vector<error_info>>>
 try_parse(const FSPATH& fpath, spec s = spec::default_version())
 {
+    if(s.memory_map_file)
+    {
+        if(auto src = detail::map_file(fpath.string()))
+        {
+            return detail::parse_impl<TC>(std::move(src), fpath.string(), std::move(s));
+        }
+    }
+
     std::ifstream ifs(fpath, std::ios_base::binary);
     if(!ifs.good())
     {
@@ -3660,6 +4009,15 @@ cxx::enable_if_t<std::is_same<FSPATH, std::filesystem::path>::value,
     basic_value<TC>>
 parse(const FSPATH& fpath, spec s = spec::default_version())
 {
+    if(s.memory_map_file)
+    {
+        if(auto src = detail::map_file(fpath.string()))
+        {
+            return detail::unwrap_or_throw(detail::parse_impl<TC>(
+                    std::move(src), fpath.string(), std::move(s)));
+        }
+    }
+
     std::ifstream ifs(fpath, std::ios_base::binary);
     if(!ifs.good())
     {
@@ -3678,115 +4036,30 @@ template<typename TC = type_config>
 result<basic_value<TC>, std::vector<error_info>>
 try_parse(FILE* fp, std::string filename, spec s = spec::default_version())
 {
-    const long beg = std::ftell(fp);
-    if (beg == -1L)
-    {
-        return err(std::vector<error_info>{error_info(
-            std::string("Failed to access: \"") + filename +
-            "\", errno = " + std::to_string(errno), {}
-        )});
-    }
-
-    const int res_seekend = std::fseek(fp, 0, SEEK_END);
-    if (res_seekend != 0)
-    {
-        return err(std::vector<error_info>{error_info(
-            std::string("Failed to seek: \"") + filename +
-            "\", errno = " + std::to_string(errno), {}
-        )});
-    }
-
-    const long end = std::ftell(fp);
-    if (end == -1L)
-    {
-        return err(std::vector<error_info>{error_info(
-            std::string("Failed to access: \"") + filename +
-            "\", errno = " + std::to_string(errno), {}
-        )});
-    }
-
-    const auto fsize = end - beg;
-
-    const auto res_seekbeg = std::fseek(fp, beg, SEEK_SET);
-    if (res_seekbeg != 0)
+    // read whole file as a sequence of char. the file can be a pipe.
+    auto letters = detail::read_file(fp);
+    if(letters.is_err())
     {
         return err(std::vector<error_info>{error_info(
-            std::string("Failed to seek: \"") + filename +
+            std::string("Failed to read: \"") + filename +
             "\", errno = " + std::to_string(errno), {}
         )});
-
-    }
-
-    // read whole file as a sequence of char
-    assert(fsize >= 0);
-    std::vector<detail::location::char_type> letters(static_cast<std::size_t>(fsize));
-    const auto actual = std::fread(letters.data(), sizeof(char), static_cast<std::size_t>(fsize), fp);
-    if(actual != static_cast<std::size_t>(fsize))
-    {
-        return err(std::vector<error_info>{error_info(
-            std::string("File size changed: \"") + filename +
-            std::string("\" make sure that FILE* is in binary mode "
-                        "to avoid LF <-> CRLF conversion"), {}
-        )});
     }
-
-    return detail::parse_impl<TC>(std::move(letters), std::move(filename), std::move(s));
+    return detail::parse_impl<TC>(std::move(letters.unwrap()), std::move(filename), std::move(s));
 }
 
 template<typename TC = type_config>
 basic_value<TC>
 parse(FILE* fp, std::string filename, spec s = spec::default_version())
 {
-    const long beg = std::ftell(fp);
-    if (beg == -1L)
-    {
-        throw file_io_error(errno, "Failed to access", filename);
-    }
-
-    const int res_seekend = std::fseek(fp, 0, SEEK_END);
-    if (res_seekend != 0)
-    {
-        throw file_io_error(errno, "Failed to seek", filename);
-    }
-
-    const long end = std::ftell(fp);
-    if (end == -1L)
-    {
-        throw file_io_error(errno, "Failed to access", filename);
-    }
-
-    const auto fsize = end - beg;
-
-    const auto res_seekbeg = std::fseek(fp, beg, SEEK_SET);
-    if (res_seekbeg != 0)
+    auto letters = detail::read_file(fp);
+    if(letters.is_err())
     {
-        throw file_io_error(errno, "Failed to seek", filename);
+        throw file_io_error(errno, "Failed to read", filename);
     }
 
-    // read whole file as a sequence of char
-    assert(fsize >= 0);
-    std::vector<detail::location::char_type> letters(static_cast<std::size_t>(fsize));
-    const auto actual = std::fread(letters.data(), sizeof(char), static_cast<std::size_t>(fsize), fp);
-    if(actual != static_cast<std::size_t>(fsize))
-    {
-        throw file_io_error(errno, "File size changed; make sure that "
-            "FILE* is in binary mode to avoid LF <-> CRLF conversion", filename);
-    }
-
-    auto res = detail::parse_impl<TC>(std::move(letters), std::move(filename), std::move(s));
-    if(res.is_ok())
-    {
-        return res.unwrap();
-    }
-    else
-    {
-        std::string msg;
-        for(const auto& err : res.unwrap_err())
-        {
-            msg += format_error(err);
-        }
-        throw syntax_error(std::move(msg), std::move(res.unwrap_err()));
-    }
+    return detail::unwrap_or_throw(detail::parse_impl<TC>(
+            std::move(letters.unwrap()), std::move(filename), std::move(s)));
 }
 
 } // TOML11_INLINE_VERSION_NAMESPACE
@@ -3805,24 +4078,28 @@ extern template result<basic_value<type_config>, std::vector<error_info>> try_pa
 extern template result<basic_value<type_config>, std::vector<error_info>> try_parse<type_config>(std::string, spec);
 extern template result<basic_value<type_config>, std::vector<error_info>> try_parse<type_config>(FILE*, std::string, spec);
 extern template result<basic_value<type_config>, std::vector<error_info>> try_parse_str<type_config>(std::string, spec, cxx::source_location);
+extern template result<basic_value<type_config>, std::vector<error_info>> try_parse_view<type_config>(const char*, std::size_t, std::string, spec, detach_mode);
 
 extern template basic_value<type_config> parse<type_config>(std::vector<unsigned char>, std::string, spec);
 extern template basic_value<type_config> parse<type_config>(std::istream&, std::string, spec);
 extern template basic_value<type_config> parse<type_config>(std::string, spec);
 extern template basic_value<type_config> parse<type_config>(FILE*, std::string, spec);
 extern template basic_value<type_config> parse_str<type_config>(std::string, spec, cxx::source_location);
+extern template basic_value<type_config> parse_view<type_config>(const char*, std::size_t, std::string, spec, detach_mode);
 
 extern template result<basic_value<ordered_type_config>, std::vector<error_info>> try_parse<ordered_type_config>(std::vector<unsigned char>, std::string, spec);
 extern template result<basic_value<ordered_type_config>, std::vector<error_info>> try_parse<ordered_type_config>(std::istream&, std::string, spec);
 extern template result<basic_value<ordered_type_config>, std::vector<error_info>> try_parse<ordered_type_config>(std::string, spec);
 extern template result<basic_value<ordered_type_config>, std::vector<error_info>> try_parse<ordered_type_config>(FILE*, std::string, spec);
 extern template result<basic_value<ordered_type_config>, std::vector<error_info>> try_parse_str<ordered_type_config>(std::string, spec, cxx::source_location);
+extern template result<basic_value<ordered_type_config>, std::vector<error_info>> try_parse_view<ordered_type_config>(const char*, std::size_t, std::string, spec, detach_mode);
 
 extern template basic_value<ordered_type_config> parse<ordered_type_config>(std::vector<unsigned char>, std::string, spec);
 extern template basic_value<ordered_type_config> parse<ordered_type_config>(std::istream&, std::string, spec);
 extern template basic_value<ordered_type_config> parse<ordered_type_config>(std::string, spec);
 extern template basic_value<ordered_type_config> parse<ordered_type_config>(FILE*, std::string, spec);
 extern template basic_value<ordered_type_config> parse_str<ordered_type_config>(std::string, spec, cxx::source_location);
+extern template basic_value<ordered_type_config> parse_view<ordered_type_config>(const char*, std::size_t, std::string, spec, detach_mode);
 
 #if defined(TOML11_HAS_FILESYSTEM)
 extern template cxx::enable_if_t<std::is_same<std::filesystem::path, std::filesystem::path>::value, result<basic_value<type_config>,         std::vector<error_info>>> try_parse<type_config,         std::filesystem::path>(const std::filesystem::path&, spec);
@@ -190,7 +190,7 @@ class serializer
             if(this->spec_.ext_num_suffix && ! fmt.suffix.empty())
             {
                 retval += '_';
-                retval += fmt.suffix;
+                retval += fmt.suffix.str();
             }
         }
         else
@@ -326,7 +326,7 @@ class serializer
                 if(this->spec_.ext_num_suffix && ! fmt.suffix.empty())
                 {
                     s += '_';
-                    s += fmt.suffix;
+                    s += fmt.suffix.str();
                 }
                 return string_conv<string_type>(s);
             }
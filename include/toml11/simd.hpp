@@ -0,0 +1,10 @@
+#ifndef TOML11_SIMD_HPP
+#define TOML11_SIMD_HPP
+
+#include "fwd/simd_fwd.hpp" // IWYU pragma: export
+
+#if ! defined(TOML11_COMPILE_SOURCES)
+#include "impl/simd_impl.hpp" // IWYU pragma: export
+#endif
+
+#endif // TOML11_SIMD_HPP
@@ -4,6 +4,8 @@
 #include "context.hpp"
 #include "region.hpp"
 #include "scanner.hpp"
+#include "simd.hpp"
+#include "static_syntax.hpp"
 #include "syntax.hpp"
 #include "types.hpp"
 #include "version.hpp"
@@ -20,16 +22,15 @@ namespace detail
 template<typename TC>
 bool skip_whitespace(location& loc, const context<TC>& ctx)
 {
-    return syntax::ws(ctx.toml_spec()).scan(loc).is_ok();
+    return static_skip<static_syntax::ws>(loc, ctx.toml_spec());
 }
 
 template<typename TC>
 bool skip_empty_lines(location& loc, const context<TC>& ctx)
 {
-    return repeat_at_least(1, sequence(
-            syntax::ws(ctx.toml_spec()),
-            syntax::newline(ctx.toml_spec())
-        )).scan(loc).is_ok();
+    using empty_lines = static_scanner::repeat_at_least<1,
+        static_scanner::sequence<static_syntax::ws, static_syntax::newline>>;
+    return static_skip<empty_lines>(loc, ctx.toml_spec());
 }
 
 // For error recovery.
@@ -44,17 +45,13 @@ void skip_comment_block(location& loc, const context<TC>& ctx)
         skip_whitespace(loc, ctx);
         if(loc.current() == '#')
         {
-            while( ! loc.eof())
-            {
-                // both CRLF and LF ends with LF.
-                if(loc.current() == '\n')
-                {
-                    loc.advance();
-                    break;
-                }
-            }
+            // both CRLF and LF ends with LF.
+            const auto& src  = *loc.source();
+            const auto first = src.data() + loc.get_location();
+            const auto eol   = find_newline(first, src.data() + src.size());
+            loc.advance(static_cast<std::size_t>(eol - first) + 1); // stops at eof
         }
-        else if(syntax::newline(ctx.toml_spec()).scan(loc).is_ok())
+        else if(static_skip<static_syntax::newline>(loc, ctx.toml_spec()))
         {
             ; // an empty line. skip this also
         }
@@ -70,12 +67,10 @@ void skip_comment_block(location& loc, const context<TC>& ctx)
 template<typename TC>
 void skip_empty_or_comment_lines(location& loc, const context<TC>& ctx)
 {
-    const auto& spec = ctx.toml_spec();
-    repeat_at_least(0, sequence(
-            syntax::ws(spec),
-            maybe(syntax::comment(spec)),
-            syntax::newline(spec))
-        ).scan(loc);
+    using empty_or_comment_lines = static_scanner::repeat_at_least<0,
+        static_scanner::sequence<static_syntax::ws,
+            static_scanner::maybe<static_syntax::comment>, static_syntax::newline>>;
+    static_skip<empty_or_comment_lines>(loc, ctx.toml_spec());
     return ;
 }
 
@@ -87,25 +82,28 @@ void skip_empty_or_comment_lines(location& loc, const context<TC>& ctx)
 // to check the syntax. Here we just skip string-like region until closing quote
 // is found.
 template<typename TC>
-void skip_string_like(location& loc, const context<TC>&)
+void skip_string_like(location& loc, const context<TC>& ctx)
 {
+    using ml_basic_quotes   = static_scanner::literal<'"',  '"',  '"'>;
+    using ml_literal_quotes = static_scanner::literal<'\'', '\'', '\''>;
+
     // if """ is found, skip until the closing """ is found.
-    if(literal("\"\"\"").scan(loc).is_ok())
+    if(static_skip<ml_basic_quotes>(loc, ctx.toml_spec()))
     {
         while( ! loc.eof())
         {
-            if(literal("\"\"\"").scan(loc).is_ok())
+            if(static_skip<ml_basic_quotes>(loc, ctx.toml_spec()))
             {
                 return;
             }
             loc.advance();
         }
     }
-    else if(literal("'''").scan(loc).is_ok())
+    else if(static_skip<ml_literal_quotes>(loc, ctx.toml_spec()))
     {
         while( ! loc.eof())
         {
-            if(literal("'''").scan(loc).is_ok())
+            if(static_skip<ml_literal_quotes>(loc, ctx.toml_spec()))
             {
                 return;
             }
@@ -176,11 +174,11 @@ void skip_array_like(location& loc, const context<TC>& ctx)
         }
         else if(loc.current() == '[')
         {
-            const auto checkpoint = loc;
-            if(syntax::std_table(spec).scan(loc).is_ok() ||
-               syntax::array_table(spec).scan(loc).is_ok())
+            const auto checkpoint = loc.get_cursor();
+            if(static_skip<static_syntax::std_table>(loc, spec) ||
+               static_skip<static_syntax::array_table>(loc, spec))
             {
-                loc = checkpoint;
+                loc.reset(checkpoint);
                 break;
             }
             // if it is not a table-definition, then it is an array.
@@ -243,11 +241,11 @@ void skip_inline_table_like(location& loc, const context<TC>& ctx)
         }
         else if(loc.current() == '[')
         {
-            const auto checkpoint = loc;
-            if(syntax::std_table(spec).scan(loc).is_ok() ||
-               syntax::array_table(spec).scan(loc).is_ok())
+            const auto checkpoint = loc.get_cursor();
+            if(static_skip<static_syntax::std_table>(loc, spec) ||
+               static_skip<static_syntax::array_table>(loc, spec))
             {
-                loc = checkpoint;
+                loc.reset(checkpoint);
                 break; // missing closing `}`.
             }
             // if it is not a table-definition, then it is an array.
@@ -337,17 +335,17 @@ void skip_until_next_table(location& loc, const context<TC>& ctx)
         if(loc.current() == '\n')
         {
             loc.advance();
-            const auto line_begin = loc;
+            const auto line_begin = loc.get_cursor();
 
             skip_whitespace(loc, ctx);
-            if(syntax::std_table(spec).scan(loc).is_ok())
+            if(static_skip<static_syntax::std_table>(loc, spec))
             {
-                loc = line_begin;
+                loc.reset(line_begin);
                 return ;
             }
-            if(syntax::array_table(spec).scan(loc).is_ok())
+            if(static_skip<static_syntax::array_table>(loc, spec))
             {
-                loc = line_begin;
+                loc.reset(line_begin);
                 return ;
             }
         }
@@ -104,7 +104,8 @@ struct spec
           ext_allow_non_english_in_bare_keys{false},
           ext_hex_float {false},
           ext_num_suffix{false},
-          ext_null_value{false}
+          ext_null_value{false},
+          memory_map_file{false}
     {}
 
     semantic_version version; // toml version
@@ -124,10 +125,15 @@ struct spec
     bool ext_hex_float;  // allow hex float (in C++ style)
     bool ext_num_suffix; // allow number suffix (in C++ style)
     bool ext_null_value; // allow `null` as a value
+
+    // parser options (do not change the syntax)
+    bool memory_map_file; // read a file via mmap instead of copying it
 };
 
 namespace detail
 {
+// parser options such as `memory_map_file` do not change the accepted syntax,
+// so they are not a part of the comparison.
 inline std::pair<const semantic_version&, std::array<bool, 10>>
 to_tuple(const spec& s) noexcept
 {
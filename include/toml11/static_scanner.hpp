@@ -0,0 +1,409 @@
+#ifndef TOML11_STATIC_SCANNER_HPP
+#define TOML11_STATIC_SCANNER_HPP
+
+#include "location.hpp"
+#include "region.hpp"
+#include "spec.hpp"
+#include "version.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace toml
+{
+inline namespace TOML11_INLINE_VERSION_NAMESPACE
+{
+namespace detail
+{
+
+// ----------------------------------------------------------------------------
+// Compile-time counterparts of the scanners in scanner.hpp.
+//
+// Each scanner is a type with a static member function
+//
+//   static char_type const* scan(char_type const* first,
+//                                char_type const* last, const spec&) noexcept;
+//
+// that returns the end of the matched range, or nullptr if it does not match.
+// Since the whole grammar is encoded in a type, a scan is expanded into
+// straight-line code without virtual calls, heap allocations, or copies of
+// `location`. The runtime scanners are still used to make error messages
+// (`expected_chars`).
+//
+// A scanner may depend on `spec`. `if_spec` chooses one of two scanners by
+// a flag in `spec` at runtime.
+//
+// Each scanner also has the FIRST set, the set of characters a match can start
+// with, and `nullable`, whether it matches an empty range. `either` looks them
+// up to skip an alternative that cannot match the current character without
+// calling it.
+//
+//   static constexpr bool nullable;
+//   static constexpr std::uint64_t first_chars(std::size_t i) noexcept;
+//
+// `first_chars(i)` returns the i-th 64-bit word of the 256-bit FIRST set.
+//
+// To avoid testing the same character twice, the FIRST set is not checked
+// before a scanner that starts with a test of one character by itself
+// (`tests_first_char`), like `character` or `literal`.
+
+namespace static_scanner
+{
+
+using char_type = location::char_type;
+using iterator  = char_type const*;
+
+// bits [lo, hi] of a 64-bit word
+constexpr std::uint64_t bit_range(const std::size_t lo, const std::size_t hi) noexcept
+{
+    return (~std::uint64_t(0) >> (63 - hi)) & (~std::uint64_t(0) << lo);
+}
+// characters [from, to] in the i-th word of a 256-bit set
+constexpr std::uint64_t char_range_bits(const std::size_t from,
+        const std::size_t to, const std::size_t i) noexcept
+{
+    return (to < i * 64 || i * 64 + 63 < from) ? std::uint64_t(0) :
+        bit_range(from < i * 64     ? 0  : from - i * 64,
+                  i * 64 + 63 < to  ? 63 : to   - i * 64);
+}
+
+template<typename T>
+struct first_set
+{
+    static constexpr std::uint64_t words[4] = {
+        T::first_chars(0), T::first_chars(1), T::first_chars(2), T::first_chars(3)
+    };
+    static bool contains(const char_type c) noexcept
+    {
+        return ((words[c >> 6] >> (c & 63)) & 1u) != 0;
+    }
+};
+template<typename T>
+constexpr std::uint64_t first_set<T>::words[4];
+
+// false if `T` never matches at `iter`. If `T` tests the first character
+// by itself, it does not look up the FIRST set.
+template<typename T>
+bool may_start_with(const iterator iter, const iterator last) noexcept
+{
+    return T::tests_first_char || T::nullable ||
+           (iter != last && first_set<T>::contains(*iter));
+}
+
+template<char_type C>
+struct character
+{
+    static constexpr bool nullable         = false;
+    static constexpr bool tests_first_char = true;
+    static constexpr std::uint64_t first_chars(const std::size_t i) noexcept
+    {
+        return char_range_bits(C, C, i);
+    }
+    static iterator scan(iterator iter, iterator last, const spec&) noexcept
+    {
+        return (iter != last && *iter == C) ? iter + 1 : nullptr;
+    }
+};
+
+template<char_type From, char_type To>
+struct character_in_range
+{
+    static constexpr bool nullable         = false;
+    static constexpr bool tests_first_char = true;
+    static constexpr std::uint64_t first_chars(const std::size_t i) noexcept
+    {
+        return char_range_bits(From, To, i);
+    }
+    static iterator scan(iterator iter, iterator last, const spec&) noexcept
+    {
+        return (iter != last && From <= *iter && *iter <= To) ? iter + 1 : nullptr;
+    }
+};
+
+template<char_type ... Cs>
+struct character_either;
+
+template<>
+struct character_either<>
+{
+    static constexpr bool contains(const char_type) noexcept {return false;}
+    static constexpr std::uint64_t first_chars(const std::size_t) noexcept
+    {
+        return 0;
+    }
+};
+template<char_type C, char_type ... Cs>
+struct character_either<C, Cs...>
+{
+    static constexpr bool nullable         = false;
+    static constexpr bool tests_first_char = true;
+    static constexpr std::uint64_t first_chars(const std::size_t i) noexcept
+    {
+        return char_range_bits(C, C, i) | character_either<Cs...>::first_chars(i);
+    }
+    static constexpr bool contains(const char_type c) noexcept
+    {
+        return c == C || character_either<Cs...>::contains(c);
+    }
+    static iterator scan(iterator iter, iterator last, const spec&) noexcept
+    {
+        return (iter != last && contains(*iter)) ? iter + 1 : nullptr;
+    }
+};
+
+template<char_type ... Cs>
+struct literal;
+
+template<>
+struct literal<>
+{
+    static constexpr bool nullable         = true;
+    static constexpr bool tests_first_char = false;
+    static constexpr std::uint64_t first_chars(const std::size_t) noexcept
+    {
+        return 0;
+    }
+    static iterator scan(iterator iter, iterator, const spec&) noexcept
+    {
+        return iter;
+    }
+};
+template<char_type C, char_type ... Cs>
+struct literal<C, Cs...>
+{
+    static constexpr bool nullable         = false;
+    static constexpr bool tests_first_char = true;
+    static constexpr std::uint64_t first_chars(const std::size_t i) noexcept
+    {
+        return char_range_bits(C, C, i);
+    }
+    static iterator scan(iterator iter, iterator last, const spec& s) noexcept
+    {
+        if(iter == last || *iter != C)
+        {
+            return nullptr;
+        }
+        return literal<Cs...>::scan(iter + 1, last, s);
+    }
+};
+
+template<typename ... Ts>
+struct sequence;
+
+template<>
+struct sequence<>
+{
+    static constexpr bool nullable         = true;
+    static constexpr bool tests_first_char = false;
+    static constexpr std::uint64_t first_chars(const std::size_t) noexcept
+    {
+        return 0;
+    }
+    static iterator scan(iterator iter, iterator, const spec&) noexcept
+    {
+        return iter;
+    }
+};
+template<typename T, typename ... Ts>
+struct sequence<T, Ts...>
+{
+    static constexpr bool nullable         = T::nullable && sequence<Ts...>::nullable;
+    static constexpr bool tests_first_char = T::tests_first_char;
+    static constexpr std::uint64_t first_chars(const std::size_t i) noexcept
+    {
+        return T::first_chars(i) |
+               (T::nullable ? sequence<Ts...>::first_chars(i) : std::uint64_t(0));
+    }
+    static iterator scan(iterator iter, iterator last, const spec& s) noexcept
+    {
+        iter = T::scan(iter, last, s);
+        if( ! iter)
+        {
+            return nullptr;
+        }
+        return sequence<Ts...>::scan(iter, last, s);
+    }
+};
+
+template<typename ... Ts>
+struct either;
+
+template<>
+struct either<>
+{
+    static constexpr bool nullable         = false;
+    static constexpr bool tests_first_char = true;
+    static constexpr std::uint64_t first_chars(const std::size_t) noexcept
+    {
+        return 0;
+    }
+    static iterator scan(iterator, iterator, const spec&) noexcept
+    {
+        return nullptr;
+    }
+};
+template<typename T, typename ... Ts>
+struct either<T, Ts...>
+{
+    static constexpr bool nullable         = T::nullable || either<Ts...>::nullable;
+    static constexpr bool tests_first_char =
+        T::tests_first_char && either<Ts...>::tests_first_char;
+    static constexpr std::uint64_t first_chars(const std::size_t i) noexcept
+    {
+        return T::first_chars(i) | either<Ts...>::first_chars(i);
+    }
+
+    static iterator scan(iterator iter, iterator last, const spec& s) noexcept
+    {
+        if(may_start_with<T>(iter, last))
+        {
+            if(const auto found = T::scan(iter, last, s))
+            {
+                return found;
+            }
+        }
+        return either<Ts...>::scan(iter, last, s);
+    }
+};
+
+template<std::size_t N, typename T>
+struct repeat_exact
+{
+    static constexpr bool nullable         = N == 0 || T::nullable;
+    static constexpr bool tests_first_char = N != 0 && T::tests_first_char;
+    static constexpr std::uint64_t first_chars(const std::size_t i) noexcept
+    {
+        return N == 0 ? std::uint64_t(0) : T::first_chars(i);
+    }
+    static iterator scan(iterator iter, iterator last, const spec& s) noexcept
+    {
+        for(std::size_t i=0; i<N; ++i)
+        {
+            iter = T::scan(iter, last, s);
+            if( ! iter)
+            {
+                return nullptr;
+            }
+        }
+        return iter;
+    }
+};
+
+template<std::size_t N, typename T>
+struct repeat_at_least
+{
+    static constexpr bool nullable         = repeat_exact<N, T>::nullable;
+    static constexpr bool tests_first_char = repeat_exact<N, T>::tests_first_char;
+    static constexpr std::uint64_t first_chars(const std::size_t i) noexcept
+    {
+        return T::first_chars(i);
+    }
+    static iterator scan(iterator iter, iterator last, const spec& s) noexcept
+    {
+        iter = repeat_exact<N, T>::scan(iter, last, s);
+        if( ! iter)
+        {
+            return nullptr;
+        }
+        while(iter != last)
+        {
+            const auto found = T::scan(iter, last, s);
+            if( ! found)
+            {
+                break;
+            }
+            iter = found;
+        }
+        return iter;
+    }
+};
+
+template<typename T>
+struct maybe
+{
+    static constexpr bool nullable         = true;
+    static constexpr bool tests_first_char = false;
+    static constexpr std::uint64_t first_chars(const std::size_t i) noexcept
+    {
+        return T::first_chars(i);
+    }
+
+    static iterator scan(iterator iter, iterator last, const spec& s) noexcept
+    {
+        const auto found = T::scan(iter, last, s);
+        return found ? found : iter;
+    }
+};
+
+template<bool spec::* Flag, typename Then, typename Else>
+struct if_spec
+{
+    // the union of both, since `spec` is not known at compile time
+    static constexpr bool nullable         = Then::nullable || Else::nullable;
+    static constexpr bool tests_first_char =
+        Then::tests_first_char && Else::tests_first_char;
+    static constexpr std::uint64_t first_chars(const std::size_t i) noexcept
+    {
+        return Then::first_chars(i) | Else::first_chars(i);
+    }
+    static iterator scan(iterator iter, iterator last, const spec& s) noexcept
+    {
+        return (s.*Flag) ? Then::scan(iter, last, s) : Else::scan(iter, last, s);
+    }
+};
+
+} // static_scanner
+
+// ----------------------------------------------------------------------------
+// apply a static scanner to a location.
+
+// returns the number of matched characters, or `std::size_t(-1)` if it does
+// not match.
+template<typename Scanner>
+std::size_t static_scan_length(const location& loc, const spec& s) noexcept
+{
+    // nullptr means "no match". an empty source may not have a valid pointer.
+    static const location::char_type empty_source = '\0';
+
+    const auto& src   = *loc.source();
+    const auto  data  = src.data() ? src.data() : &empty_source;
+    const auto  first = data + loc.get_location();
+    const auto  found = Scanner::scan(first, data + src.size(), s);
+    if( ! found)
+    {
+        return static_cast<std::size_t>(-1);
+    }
+    return static_cast<std::size_t>(found - first);
+}
+
+// advances `loc` if it matches, as `scanner_base::scan` does.
+template<typename Scanner>
+region static_scan(location& loc, const spec& s)
+{
+    const auto len = static_scan_length<Scanner>(loc, s);
+    if(len == static_cast<std::size_t>(-1))
+    {
+        return region{};
+    }
+    const auto first = loc.get_cursor();
+    loc.advance(len);
+    return region(first, loc);
+}
+
+// the same as `static_scan(loc, s).is_ok()`, but does not construct a region.
+template<typename Scanner>
+bool static_skip(location& loc, const spec& s)
+{
+    const auto len = static_scan_length<Scanner>(loc, s);
+    if(len == static_cast<std::size_t>(-1))
+    {
+        return false;
+    }
+    loc.advance(len);
+    return true;
+}
+
+} // detail
+} // TOML11_INLINE_VERSION_NAMESPACE
+} // toml
+#endif // TOML11_STATIC_SCANNER_HPP
@@ -0,0 +1,446 @@
+#ifndef TOML11_STATIC_SYNTAX_HPP
+#define TOML11_STATIC_SYNTAX_HPP
+
+#include "simd.hpp"
+#include "spec.hpp"
+#include "static_scanner.hpp"
+#include "syntax.hpp"
+#include "version.hpp"
+
+#include <cstdint>
+
+namespace toml
+{
+inline namespace TOML11_INLINE_VERSION_NAMESPACE
+{
+namespace detail
+{
+// ----------------------------------------------------------------------------
+// The TOML grammar written in static scanners. Each one corresponds to the
+// function with the same name in `syntax`, which is still used to generate
+// error messages.
+namespace static_syntax
+{
+
+using static_scanner::char_type;
+using static_scanner::iterator;
+
+using static_scanner::character;
+using static_scanner::character_either;
+using static_scanner::character_in_range;
+using static_scanner::literal;
+using static_scanner::sequence;
+using static_scanner::either;
+using static_scanner::repeat_exact;
+using static_scanner::repeat_at_least;
+using static_scanner::maybe;
+using static_scanner::if_spec;
+
+// ===========================================================================
+// UTF-8
+
+using utf8_2bytes = sequence<
+    character_in_range<0xC2, 0xDF>, character_in_range<0x80, 0xBF>>;
+
+using utf8_3bytes = sequence<either<
+        sequence<character         <0xE0>,       character_in_range<0xA0, 0xBF>>,
+        sequence<character_in_range<0xE1, 0xEC>, character_in_range<0x80, 0xBF>>,
+        sequence<character         <0xED>,       character_in_range<0x80, 0x9F>>,
+        sequence<character_in_range<0xEE, 0xEF>, character_in_range<0x80, 0xBF>>
+    >, character_in_range<0x80, 0xBF>>;
+
+using utf8_4bytes = sequence<either<
+        sequence<character         <0xF0>,       character_in_range<0x90, 0xBF>>,
+        sequence<character_in_range<0xF1, 0xF3>, character_in_range<0x80, 0xBF>>,
+        sequence<character         <0xF4>,       character_in_range<0x80, 0x8F>>
+    >, character_in_range<0x80, 0xBF>, character_in_range<0x80, 0xBF>>;
+
+// The parser validates the whole input as UTF-8 before scanning it (see
+// `validate_utf8` in parser.hpp), so a byte >= 0x80 here is a part of a valid
+// multi-byte character. Every use of non_ascii is in (or followed by) a
+// repetition of it, so it consumes the rest of the character a byte at a
+// time. Use the UTF-8 sequences above for unvalidated input.
+using non_ascii = character_in_range<0x80, 0xFF>;
+
+// ===========================================================================
+// Whitespace
+
+using wschar = character_either<' ', '\t'>;
+
+// repeat_at_least<0, wschar>. Indentation is skipped a block at a time.
+struct ws
+{
+    static constexpr bool nullable         = true;
+    static constexpr bool tests_first_char = false;
+    static constexpr std::uint64_t first_chars(const std::size_t i) noexcept
+    {
+        return wschar::first_chars(i);
+    }
+    static iterator scan(iterator iter, iterator last, const spec&) noexcept
+    {
+        // most of the time, there is no or only one whitespace.
+        if(iter == last || ! wschar::contains(*iter))
+        {
+            return iter;
+        }
+        return find_first_not_wschar(iter + 1, last);
+    }
+};
+
+// ===========================================================================
+// Newline
+
+using newline = either<character<'\n'>, literal<'\r', '\n'>>;
+
+// ===========================================================================
+// Comments
+
+using allowed_comment_char = if_spec<&spec::ext_allow_control_characters_in_comments,
+    either<character_in_range<0x01, 0x09>, character_in_range<0x0E, 0x7F>, non_ascii>,
+    either<character<0x09>,                character_in_range<0x20, 0x7E>, non_ascii>
+    >;
+
+// repeat_at_least<0, allowed_comment_char>. Runs of printable ASCII, which are
+// allowed in any version, are skipped a block at a time.
+struct allowed_comment_chars
+{
+    static constexpr bool nullable         = true;
+    static constexpr bool tests_first_char = false;
+    static constexpr std::uint64_t first_chars(const std::size_t i) noexcept
+    {
+        return allowed_comment_char::first_chars(i);
+    }
+    static iterator scan(iterator iter, iterator last, const spec& s) noexcept
+    {
+        while(true)
+        {
+            iter = find_first_not_comment_ascii(iter, last);
+            if(iter == last)
+            {
+                return iter;
+            }
+            // a newline, a control character, or a non-ASCII character
+            const auto found = allowed_comment_char::scan(iter, last, s);
+            if( ! found)
+            {
+                return iter;
+            }
+            iter = found;
+        }
+    }
+};
+
+// XXX Note that it does not take newline
+using comment = sequence<character<'#'>, allowed_comment_chars>;
+
+// ===========================================================================
+// Boolean
+
+using boolean = either<literal<'t','r','u','e'>, literal<'f','a','l','s','e'>>;
+
+// ===========================================================================
+// Integer
+
+using digit  = character_in_range<'0', '9'>;
+using alpha  = either<character_in_range<'a', 'z'>, character_in_range<'A', 'Z'>>;
+using hexdig = either<digit, character_in_range<'a', 'f'>, character_in_range<'A', 'F'>>;
+
+// non-digit-graph = ([a-zA-Z]|unicode mb char)
+// graph           = ([a-zA-Z0-9]|unicode mb char)
+// suffix          = _ non-digit-graph (graph | _graph)
+using num_suffix = sequence<
+        character<'_'>,
+        either<alpha, non_ascii>,
+        repeat_at_least<0, either<
+            sequence<character<'_'>, either<alpha, digit, non_ascii>>,
+            either<alpha, digit, non_ascii>
+        >>
+    >;
+
+using dec_int = sequence<
+        maybe<character_either<'+', '-'>>,
+        either<
+            sequence<
+                character_in_range<'1', '9'>,
+                repeat_at_least<1, either<digit, sequence<character<'_'>, digit>>>
+            >,
+            digit
+        >
+    >;
+
+using hex_int = sequence<
+        literal<'0', 'x'>, hexdig,
+        repeat_at_least<0, either<hexdig, sequence<character<'_'>, hexdig>>>
+    >;
+
+using oct_int = sequence<
+        literal<'0', 'o'>, character_in_range<'0', '7'>,
+        repeat_at_least<0, either<character_in_range<'0', '7'>,
+                        sequence<character<'_'>, character_in_range<'0', '7'>>>>
+    >;
+
+using bin_int = sequence<
+        literal<'0', 'b'>, character_either<'0', '1'>,
+        repeat_at_least<0, either<character_either<'0', '1'>,
+                        sequence<character<'_'>, character_either<'0', '1'>>>>
+    >;
+
+using integer = either<hex_int, oct_int, bin_int, dec_int>;
+
+// ===========================================================================
+// Floating
+
+using zero_prefixable_int = sequence<
+        digit, repeat_at_least<0, either<digit, sequence<character<'_'>, digit>>>
+    >;
+
+using fractional_part = sequence<character<'.'>, zero_prefixable_int>;
+
+using exponent_part = sequence<
+        character_either<'e', 'E'>,
+        maybe<character_either<'+', '-'>>,
+        zero_prefixable_int
+    >;
+
+// C99 hexfloat (%a)
+// [+-]? 0x ( [0-9a-fA-F]*\.[0-9a-fA-F]+ | [0-9a-fA-F]+\.? ) [pP] [+-]? [0-9]+
+using hex_floating = sequence<
+        maybe<character_either<'+', '-'>>,
+        character<'0'>,
+        character_either<'x', 'X'>,
+        either<
+            sequence<repeat_at_least<0, hexdig>, character<'.'>, repeat_at_least<1, hexdig>>,
+            sequence<repeat_at_least<1, hexdig>, maybe<character<'.'>>>
+        >,
+        character_either<'p', 'P'>,
+        maybe<character_either<'+', '-'>>,
+        repeat_at_least<1, digit>
+    >;
+
+using floating = either<
+        sequence<
+            dec_int,
+            either<exponent_part, sequence<fractional_part, maybe<exponent_part>>>
+        >,
+        sequence<
+            maybe<character_either<'+', '-'>>,
+            either<literal<'i','n','f'>, literal<'n','a','n'>>
+        >
+    >;
+
+// ===========================================================================
+// Datetime
+
+using local_date = sequence<
+        repeat_exact<4, digit>, character<'-'>,
+        repeat_exact<2, digit>, character<'-'>,
+        repeat_exact<2, digit>
+    >;
+
+using local_time = if_spec<&spec::v1_1_0_make_seconds_optional,
+        sequence<
+            repeat_exact<2, digit>, character<':'>, repeat_exact<2, digit>,
+            maybe<sequence<
+                character<':'>, repeat_exact<2, digit>,
+                maybe<sequence<character<'.'>, repeat_at_least<1, digit>>>
+            >>
+        >,
+        sequence<
+            repeat_exact<2, digit>, character<':'>,
+            repeat_exact<2, digit>, character<':'>,
+            repeat_exact<2, digit>,
+            maybe<sequence<character<'.'>, repeat_at_least<1, digit>>>
+        >
+    >;
+
+using time_offset = either<
+        character_either<'z', 'Z'>,
+        sequence<character_either<'+', '-'>,
+                 repeat_exact<2, digit>, character<':'>, repeat_exact<2, digit>>
+    >;
+
+using full_time       = sequence<local_time, time_offset>;
+using time_delim      = character_either<'T', 't', ' '>;
+using local_datetime  = sequence<local_date, time_delim, local_time>;
+using offset_datetime = sequence<local_date, time_delim, full_time>;
+
+// ===========================================================================
+// String
+
+using escaped_x2 = sequence<character<'x'>, repeat_exact<2, hexdig>>;
+using escaped_u4 = sequence<character<'u'>, repeat_exact<4, hexdig>>;
+using escaped_U8 = sequence<character<'U'>, repeat_exact<8, hexdig>>;
+
+using escape_char = if_spec<&spec::v1_1_0_add_escape_sequence_e,
+        character_either<'"', '\\', 'b', 'f', 'n', 'r', 't', 'e'>,
+        character_either<'"', '\\', 'b', 'f', 'n', 'r', 't'>
+    >;
+
+using escaped = sequence<character<'\\'>,
+        if_spec<&spec::v1_1_0_add_escape_sequence_x,
+            either<escape_char, escaped_u4, escaped_U8, escaped_x2>,
+            either<escape_char, escaped_u4, escaped_U8>
+        >
+    >;
+
+using basic_char = either<
+        either<
+            wschar,
+            character<0x21>,                    // 22 is "
+            character_in_range<0x23, 0x5B>,     // 5C is backslash
+            character_in_range<0x5D, 0x7E>,     // 7F is DEL
+            non_ascii
+        >,
+        escaped
+    >;
+
+using basic_string = sequence<
+        character<'"'>, repeat_at_least<0, basic_char>, character<'"'>
+    >;
+
+// ---------------------------------------------------------------------------
+// multiline string
+
+using escaped_newline = sequence<
+        character<'\\'>, ws, newline,
+        repeat_at_least<0, either<wschar, newline>>
+    >;
+
+using ml_basic_string = sequence<
+        literal<'"', '"', '"'>,
+        maybe<newline>,
+        repeat_at_least<0, either<basic_char, newline, escaped_newline>>,
+        repeat_at_least<0, sequence<
+            either<literal<'"', '"'>, character<'"'>>,
+            repeat_at_least<1, either<basic_char, newline, escaped_newline>>
+        >>,
+        // XXX """ and mlb_quotes are intentionally reordered to avoid
+        //     unexpected match of mlb_quotes
+        literal<'"', '"', '"'>,
+        maybe<either<literal<'"', '"'>, character<'"'>>>
+    >;
+
+// ---------------------------------------------------------------------------
+// literal string
+
+using literal_char = either<
+        character<0x09>,
+        character_in_range<0x20, 0x26>,
+        character_in_range<0x28, 0x7E>,
+        non_ascii
+    >;
+
+using literal_string = sequence<
+        character<'\''>, repeat_at_least<0, literal_char>, character<'\''>
+    >;
+
+using ml_literal_string = sequence<
+        literal<'\'', '\'', '\''>,
+        maybe<newline>,
+        repeat_at_least<0, either<literal_char, newline>>,
+        repeat_at_least<0, sequence<
+            either<literal<'\'', '\''>, character<'\''>>,
+            repeat_at_least<1, either<literal_char, newline>>
+        >>,
+        // XXX ''' and mll_quotes are intentionally reordered to avoid
+        //     unexpected match of mll_quotes
+        literal<'\'', '\'', '\''>,
+        maybe<either<literal<'\'', '\''>, character<'\''>>>
+    >;
+
+using string = either<ml_basic_string, ml_literal_string, basic_string, literal_string>;
+
+// ===========================================================================
+// Keys
+
+// syntax::non_ascii_key_char reading from a range.
+struct non_ascii_key_char
+{
+    // leading bytes of 2, 3, and 4-byte sequences
+    static constexpr bool nullable         = false;
+    static constexpr bool tests_first_char = true;
+    static constexpr std::uint64_t first_chars(const std::size_t i) noexcept
+    {
+        return static_scanner::char_range_bits(0xC0, 0xF7, i);
+    }
+
+    static iterator scan(iterator iter, iterator last, const spec&) noexcept
+    {
+        if(iter == last) {return nullptr;}
+
+        // U+0000   ... U+0079  ; 0xxx_xxxx
+        // U+0080   ... U+07FF  ; 110y_yyyx 10xx_xxxx;
+        // U+0800   ... U+FFFF  ; 1110_yyyy 10yx_xxxx 10xx_xxxx
+        // U+010000 ... U+10FFFF; 1111_0yyy 10yy_xxxx 10xx_xxxx 10xx_xxxx
+
+        const auto b1 = *iter;
+        std::uint32_t codep = 0;
+        std::uint32_t lower = 0;
+        std::ptrdiff_t len  = 0;
+        if(b1 < 0x80)
+        {
+            return nullptr; // ASCII key characters are checked separately
+        }
+        else if((b1 >> 5) == 6) // 0b110 == 6
+        {
+            codep = static_cast<std::uint32_t>(b1 & 0x1F); lower = 0x80;    len = 2;
+        }
+        else if((b1 >> 4) == 14) // 0b1110 == 14
+        {
+            codep = static_cast<std::uint32_t>(b1 & 0x0F); lower = 0x800;   len = 3;
+        }
+        else if((b1 >> 3) == 30) // 0b11110 == 30
+        {
+            codep = static_cast<std::uint32_t>(b1 & 0x07); lower = 0x10000; len = 4;
+        }
+        else // not a Unicode codepoint in UTF-8
+        {
+            return nullptr;
+        }
+        if(last - iter < len)
+        {
+            return nullptr;
+        }
+        for(std::ptrdiff_t i=1; i<len; ++i)
+        {
+            codep = (codep << 6) + static_cast<std::uint32_t>(iter[i] & 0x3F);
+        }
+        if(codep < lower || ! syntax::is_non_ascii_key_codepoint(codep))
+        {
+            return nullptr;
+        }
+        return iter + len;
+    }
+};
+
+using unquoted_key = repeat_at_least<1,
+    if_spec<&spec::ext_allow_non_english_in_bare_keys,
+        either<alpha, digit, character<0x2D>, character<0x5F>, non_ascii_key_char>,
+        either<alpha, digit, character<0x2D>, character<0x5F>>
+    >>;
+
+using quoted_key = either<basic_string, literal_string>;
+using simple_key = either<unquoted_key, quoted_key>;
+using dot_sep    = sequence<ws, character<'.'>, ws>;
+using dotted_key = sequence<
+        simple_key, repeat_at_least<1, sequence<dot_sep, simple_key>>
+    >;
+using key        = either<dotted_key, simple_key>;
+using keyval_sep = sequence<ws, character<'='>, ws>;
+
+// ===========================================================================
+// Table key
+
+using std_table   = sequence<character<'['>, ws, key, ws, character<']'>>;
+using array_table = sequence<literal<'[', '['>, ws, key, ws, literal<']', ']'>>;
+
+// ===========================================================================
+// extension: null
+
+using null_value = literal<'n','u','l','l'>;
+
+} // static_syntax
+} // detail
+} // TOML11_INLINE_VERSION_NAMESPACE
+} // toml
+#endif // TOML11_STATIC_SYNTAX_HPP
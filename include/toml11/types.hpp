@@ -4,11 +4,13 @@
 #include "comments.hpp"
 #include "compat.hpp"
 #include "error_info.hpp"
+#include "float_reader.hpp"
 #include "format.hpp"
 #include "ordered_map.hpp"
 #include "value.hpp"
 #include "version.hpp"
 
+#include <locale>
 #include <ostream>
 #include <sstream>
 #include <string>
@@ -18,6 +20,7 @@
 
 #include <cstdint>
 #include <cstdio>
+#include <limits>
 
 namespace toml
 {
@@ -35,67 +38,197 @@ class basic_value;
 //
 // Before this functions is called, syntax is checked and prefix(`0x` etc) and
 // spacer(`_`) are removed.
+//
+// The location is passed as a `detail::region` that refers to the input, and
+// `source_location` is constructed only when an error occurs, because it
+// copies the lines. For compatibility, the read functions also accept a
+// `source_location`. `detail::region` is not a part of the public interface;
+// a user-defined type_config takes a `source_location` as documented.
+
+namespace detail
+{
+inline source_location const& to_source_location(const source_location& src) noexcept
+{
+    return src;
+}
+inline source_location to_source_location(const region& reg)
+{
+    return source_location(reg);
+}
 
+// Built-in integer types are read by accumulating digits, without
+// constructing std::istringstream for each integer. Other types (e.g.
+// boost::multiprecision) use the stream-based implementation.
 template<typename T>
+using is_builtin_integer = cxx::conjunction<
+        std::is_integral<T>,
+        cxx::negation<std::is_same<cxx::remove_cvref_t<T>, bool>>
+    >;
+
+inline int int_digit_value(const char c) noexcept
+{
+    if('0' <= c && c <= '9') {return c - '0';}
+    if('a' <= c && c <= 'f') {return c - 'a' + 10;}
+    if('A' <= c && c <= 'F') {return c - 'A' + 10;}
+    return 36; // larger than any base
+}
+
+template<typename T>
+bool read_int_digits_stream(const std::string& str, const int base, T& val)
+{
+    std::istringstream iss(str);
+    switch(base)
+    {
+        case  8: {iss >> std::oct >> val; break;}
+        case 16: {iss >> std::hex >> val; break;}
+        default: {iss >> val; break;}
+    }
+    return ! iss.fail();
+}
+
+// returns false if the value is out of range or str contains invalid digit
+template<typename T>
+cxx::enable_if_t<cxx::negation<is_builtin_integer<T>>::value, bool>
+read_int_digits(const std::string& str, const int base, T& val)
+{
+    return read_int_digits_stream(str, base, val);
+}
+// Accumulates digits from the most significant one, checking that the value
+// fits in T. It is shared by read_int and the parser, which reads integers of
+// the built-in type configs by itself.
+template<typename T>
+class int_accumulator
+{
+  public:
+    using value_type    = T;
+    using unsigned_type = typename std::make_unsigned<T>::type;
+
+    int_accumulator(const int base, const bool negative) noexcept
+        : negative_(negative), base_(static_cast<unsigned_type>(base)),
+          limit_(negative ?
+            static_cast<unsigned_type>(static_cast<unsigned_type>((std::numeric_limits<T>::max)()) + 1u) :
+            static_cast<unsigned_type>((std::numeric_limits<T>::max)())),
+          acc_(0)
+    {}
+
+    // returns false if the value overflows. d must be less than the base.
+    bool push(const int d) noexcept
+    {
+        const auto ud = static_cast<unsigned_type>(d);
+        if((this->limit_ - ud) / this->base_ < this->acc_)
+        {
+            return false;
+        }
+        this->acc_ = static_cast<unsigned_type>(this->acc_ * this->base_ + ud);
+        return true;
+    }
+
+    T value() const noexcept
+    {
+        if(this->negative_ && this->acc_ != 0)
+        {
+            // -(acc-1)-1 to avoid overflow when acc == max+1
+            return static_cast<T>(-static_cast<T>(this->acc_ - 1u) - 1);
+        }
+        return static_cast<T>(this->acc_);
+    }
+
+  private:
+    bool          negative_;
+    unsigned_type base_;
+    unsigned_type limit_;
+    unsigned_type acc_;
+};
+
+template<typename T>
+cxx::enable_if_t<is_builtin_integer<T>::value, bool>
+read_int_digits(const std::string& str, const int base, T& val)
+{
+    auto iter = str.begin();
+    bool negative = false;
+    if(iter != str.end() && (*iter == '+' || *iter == '-'))
+    {
+        negative = (*iter == '-');
+        ++iter;
+    }
+    if(negative && std::is_unsigned<T>::value)
+    {
+        // same as std::istream (it negates the unsigned value)
+        return read_int_digits_stream(str, base, val);
+    }
+    if(iter == str.end())
+    {
+        return false;
+    }
+
+    int_accumulator<T> acc(base, negative);
+    for(; iter != str.end(); ++iter)
+    {
+        const int d = int_digit_value(*iter);
+        if(base <= d || ! acc.push(d))
+        {
+            return false;
+        }
+    }
+    val = acc.value();
+    return true;
+}
+} // detail
+
+template<typename T, typename Location>
 result<T, error_info>
-read_dec_int(const std::string& str, const source_location src)
+read_dec_int(const std::string& str, const Location& src)
 {
     constexpr auto max_digits = std::numeric_limits<T>::digits;
     assert( ! str.empty());
 
     T val{0};
-    std::istringstream iss(str);
-    iss >> val;
-    if(iss.fail())
+    if( ! detail::read_int_digits(str, 10, val))
     {
         return err(make_error_info("toml::parse_dec_integer: "
             "too large integer: current max digits = 2^" + std::to_string(max_digits),
-            std::move(src), "must be < 2^" + std::to_string(max_digits)));
+            detail::to_source_location(src), "must be < 2^" + std::to_string(max_digits)));
     }
     return ok(val);
 }
 
-template<typename T>
+template<typename T, typename Location>
 result<T, error_info>
-read_hex_int(const std::string& str, const source_location src)
+read_hex_int(const std::string& str, const Location& src)
 {
     constexpr auto max_digits = std::numeric_limits<T>::digits;
     assert( ! str.empty());
 
     T val{0};
-    std::istringstream iss(str);
-    iss >> std::hex >> val;
-    if(iss.fail())
+    if( ! detail::read_int_digits(str, 16, val))
     {
         return err(make_error_info("toml::parse_hex_integer: "
             "too large integer: current max value = 2^" + std::to_string(max_digits),
-            std::move(src), "must be < 2^" + std::to_string(max_digits)));
+            detail::to_source_location(src), "must be < 2^" + std::to_string(max_digits)));
     }
     return ok(val);
 }
 
-template<typename T>
+template<typename T, typename Location>
 result<T, error_info>
-read_oct_int(const std::string& str, const source_location src)
+read_oct_int(const std::string& str, const Location& src)
 {
     constexpr auto max_digits = std::numeric_limits<T>::digits;
     assert( ! str.empty());
 
     T val{0};
-    std::istringstream iss(str);
-    iss >> std::oct >> val;
-    if(iss.fail())
+    if( ! detail::read_int_digits(str, 8, val))
     {
         return err(make_error_info("toml::parse_oct_integer: "
             "too large integer: current max value = 2^" + std::to_string(max_digits),
-            std::move(src), "must be < 2^" + std::to_string(max_digits)));
+            detail::to_source_location(src), "must be < 2^" + std::to_string(max_digits)));
     }
     return ok(val);
 }
 
-template<typename T>
+template<typename T, typename Location>
 result<T, error_info>
-read_bin_int(const std::string& str, const source_location src)
+read_bin_int(const std::string& str, const Location& src)
 {
     constexpr auto is_bounded =  std::numeric_limits<T>::is_bounded;
     constexpr auto max_digits =  std::numeric_limits<T>::digits;
@@ -137,14 +270,14 @@ read_bin_int(const std::string& str, const source_location src)
     {
         return err(make_error_info("toml::parse_bin_integer: "
             "too large integer: current max value = 2^" + std::to_string(max_digits),
-            std::move(src), "must be < 2^" + std::to_string(max_digits)));
+            detail::to_source_location(src), "must be < 2^" + std::to_string(max_digits)));
     }
     return ok(val);
 }
 
-template<typename T>
+template<typename T, typename Location>
 result<T, error_info>
-read_int(const std::string& str, const source_location src, const std::uint8_t base)
+read_int(const std::string& str, const Location& src, const std::uint8_t base)
 {
     assert(base == 10 || base == 16 || base == 8 || base == 2);
     switch(base)
@@ -160,8 +293,9 @@ read_int(const std::string& str, const source_location src, const std::uint8_t b
     }
 }
 
-inline result<float, error_info>
-read_hex_float(const std::string& str, const source_location src, float val)
+template<typename Location>
+result<float, error_info>
+read_hex_float(const std::string& str, const Location& src, float val)
 {
 #if defined(_MSC_VER) && ! defined(__clang__)
     const auto res = ::sscanf_s(str.c_str(), "%a", std::addressof(val));
@@ -172,12 +306,13 @@ read_hex_float(const std::string& str, const source_location src, float val)
     {
         return err(make_error_info("toml::parse_floating: "
             "failed to read hexadecimal floating point value ",
-            std::move(src), "here"));
+            detail::to_source_location(src), "here"));
     }
     return ok(val);
 }
-inline result<double, error_info>
-read_hex_float(const std::string& str, const source_location src, double val)
+template<typename Location>
+result<double, error_info>
+read_hex_float(const std::string& str, const Location& src, double val)
 {
 #if defined(_MSC_VER) && ! defined(__clang__)
     const auto res = ::sscanf_s(str.c_str(), "%la", std::addressof(val));
@@ -188,41 +323,74 @@ read_hex_float(const std::string& str, const source_location src, double val)
     {
         return err(make_error_info("toml::parse_floating: "
             "failed to read hexadecimal floating point value ",
-            std::move(src), "here"));
+            detail::to_source_location(src), "here"));
     }
     return ok(val);
 }
-template<typename T>
+template<typename T, typename Location>
 cxx::enable_if_t<cxx::conjunction<
     cxx::negation<std::is_same<cxx::remove_cvref_t<T>, double>>,
     cxx::negation<std::is_same<cxx::remove_cvref_t<T>, float>>
     >::value, result<T, error_info>>
-read_hex_float(const std::string&, const source_location src, T)
+read_hex_float(const std::string&, const Location& src, T)
 {
     return err(make_error_info("toml::parse_floating: failed to read "
         "floating point value because of unknown type in type_config",
-        std::move(src), "here"));
+        detail::to_source_location(src), "here"));
 }
 
+namespace detail
+{
 template<typename T>
-result<T, error_info>
-read_dec_float(const std::string& str, const source_location src)
+bool read_float_digits_stream(const std::string& str, T& val)
 {
-    T val;
     std::istringstream iss(str);
+    iss.imbue(std::locale::classic());
     iss >> val;
-    if(iss.fail())
+    return ! iss.fail();
+}
+
+// `float` and `double` are read by Eisel-Lemire algorithm (see float_reader.hpp).
+// It falls back to the stream-based implementation in the rare hard cases.
+template<typename T>
+cxx::enable_if_t<cxx::disjunction<
+        std::is_same<T, double>, std::is_same<T, float>
+    >::value, bool>
+read_float_digits(const std::string& str, T& val)
+{
+    if(read_dec_float_fast(str.data(), str.data() + str.size(), val))
+    {
+        return true;
+    }
+    return read_float_digits_stream(str, val);
+}
+template<typename T>
+cxx::enable_if_t<cxx::negation<cxx::disjunction<
+        std::is_same<T, double>, std::is_same<T, float>
+    >>::value, bool>
+read_float_digits(const std::string& str, T& val)
+{
+    return read_float_digits_stream(str, val);
+}
+} // detail
+
+template<typename T, typename Location>
+result<T, error_info>
+read_dec_float(const std::string& str, const Location& src)
+{
+    T val;
+    if( ! detail::read_float_digits(str, val))
     {
         return err(make_error_info("toml::parse_floating: "
             "failed to read floating point value from stream",
-            std::move(src), "here"));
+            detail::to_source_location(src), "here"));
     }
     return ok(val);
 }
 
-template<typename T>
+template<typename T, typename Location>
 result<T, error_info>
-read_float(const std::string& str, const source_location src, const bool is_hex)
+read_float(const std::string& str, const Location& src, const bool is_hex)
 {
     if(is_hex)
     {
@@ -248,6 +416,18 @@ struct type_config
     template<typename K, typename T>
     using table_type = std::unordered_map<K, T>;
 
+    static result<integer_type, error_info>
+    parse_int(const std::string& str, const detail::region& reg, const std::uint8_t base)
+    {
+        return read_int<integer_type>(str, reg, base);
+    }
+    static result<floating_type, error_info>
+    parse_float(const std::string& str, const detail::region& reg, const bool is_hex)
+    {
+        return read_float<floating_type>(str, reg, is_hex);
+    }
+
+    // for compatibility. the parser calls the above.
     static result<integer_type, error_info>
     parse_int(const std::string& str, const source_location src, const std::uint8_t base)
     {
@@ -264,6 +444,13 @@ using value = basic_value<type_config>;
 using table = typename value::table_type;
 using array = typename value::array_type;
 
+// It is the largest part of the memory used by a document. The budget is for
+// 64-bit platforms with 32-byte std::string, e.g. libstdc++ and MSVC release.
+#ifndef TOML11_ENABLE_ACCESS_CHECK
+static_assert(sizeof(void*) != 8 || sizeof(std::string) != 32 || sizeof(value) <= 80,
+              "toml::value should fit in 80 bytes");
+#endif
+
 struct ordered_type_config
 {
     using comment_type  = preserve_comments;
@@ -278,6 +465,18 @@ struct ordered_type_config
     template<typename K, typename T>
     using table_type = ordered_map<K, T>;
 
+    static result<integer_type, error_info>
+    parse_int(const std::string& str, const detail::region& reg, const std::uint8_t base)
+    {
+        return read_int<integer_type>(str, reg, base);
+    }
+    static result<floating_type, error_info>
+    parse_float(const std::string& str, const detail::region& reg, const bool is_hex)
+    {
+        return read_float<floating_type>(str, reg, is_hex);
+    }
+
+    // for compatibility. the parser calls the above.
     static result<integer_type, error_info>
     parse_int(const std::string& str, const source_location src, const std::uint8_t base)
     {
@@ -300,6 +499,27 @@ using ordered_array = typename ordered_value::array_type;
 namespace detail
 {
 
+// parse_int of the built-in type configs only calls read_int. If TC::parse_int
+// that the parser calls is one of them, e.g. TC derives from type_config and
+// does not define its own, the parser reads integers by itself without calling
+// TC::parse_int. A user-defined parse_int is always called, even if it does
+// the same thing.
+using default_parse_int_type = result<std::int64_t, error_info>(*)(
+        const std::string&, const region&, const std::uint8_t);
+
+template<typename TC, typename U = void>
+struct has_default_parse_int: std::false_type{};
+template<typename TC>
+struct has_default_parse_int<TC, cxx::void_t<decltype(
+        static_cast<default_parse_int_type>(&TC::parse_int))>>
+    : std::integral_constant<bool,
+        std::is_same<typename TC::integer_type, std::int64_t>::value && (
+        static_cast<default_parse_int_type>(&TC::parse_int) ==
+        static_cast<default_parse_int_type>(&type_config::parse_int) ||
+        static_cast<default_parse_int_type>(&TC::parse_int) ==
+        static_cast<default_parse_int_type>(&ordered_type_config::parse_int))>
+{};
+
 // ----------------------------------------------------------------------------
 // check if type T has all the needed member types
 
@@ -351,6 +571,25 @@ struct has_parse_float<T, cxx::void_t<decltype(std::declval<T>().parse_float(
         std::declval<bool>()
     ))>>: std::true_type{};
 
+// parse_int/parse_float that receives the location lazily, as a region.
+template<typename T, typename U = void>
+struct has_lazy_parse_int: std::false_type{};
+template<typename T>
+struct has_lazy_parse_int<T, cxx::void_t<decltype(std::declval<T>().parse_int(
+        std::declval<std::string const&>(),
+        std::declval<region const&>(),
+        std::declval<std::uint8_t>()
+    ))>>: std::true_type{};
+
+template<typename T, typename U = void>
+struct has_lazy_parse_float: std::false_type{};
+template<typename T>
+struct has_lazy_parse_float<T, cxx::void_t<decltype(std::declval<T>().parse_float(
+        std::declval<std::string const&>(),
+        std::declval<region const&>(),
+        std::declval<bool>()
+    ))>>: std::true_type{};
+
 template<typename T>
 using is_type_config = cxx::conjunction<
     has_comment_type<T>,
@@ -359,10 +598,43 @@ using is_type_config = cxx::conjunction<
     has_string_type<T>,
     has_array_type<T>,
     has_table_type<T>,
-    has_parse_int<T>,
-    has_parse_float<T>
+    cxx::disjunction<has_lazy_parse_int<T>,   has_parse_int<T>>,
+    cxx::disjunction<has_lazy_parse_float<T>, has_parse_float<T>>
     >;
 
+// If TC::parse_int/parse_float takes a region, source_location is constructed
+// only if it fails. Otherwise, construct source_location before calling it.
+
+template<typename TC>
+cxx::enable_if_t<has_lazy_parse_int<TC>::value,
+    result<typename TC::integer_type, error_info>>
+call_parse_int(const std::string& str, const region& reg, const std::uint8_t base)
+{
+    return TC::parse_int(str, reg, base);
+}
+template<typename TC>
+cxx::enable_if_t<cxx::negation<has_lazy_parse_int<TC>>::value,
+    result<typename TC::integer_type, error_info>>
+call_parse_int(const std::string& str, const region& reg, const std::uint8_t base)
+{
+    return TC::parse_int(str, source_location(reg), base);
+}
+
+template<typename TC>
+cxx::enable_if_t<has_lazy_parse_float<TC>::value,
+    result<typename TC::floating_type, error_info>>
+call_parse_float(const std::string& str, const region& reg, const bool is_hex)
+{
+    return TC::parse_float(str, reg, is_hex);
+}
+template<typename TC>
+cxx::enable_if_t<cxx::negation<has_lazy_parse_float<TC>>::value,
+    result<typename TC::floating_type, error_info>>
+call_parse_float(const std::string& str, const region& reg, const bool is_hex)
+{
+    return TC::parse_float(str, source_location(reg), is_hex);
+}
+
 } // namespace detail
 } // TOML11_INLINE_VERSION_NAMESPACE
 } // namespace toml
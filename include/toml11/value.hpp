@@ -59,6 +59,18 @@ error_info make_not_found_error(const basic_value<TC>&, const std::string&, cons
 template<typename TC>
 void change_region_of_value(basic_value<TC>&, const basic_value<TC>&);
 
+template<typename TC>
+void add_regions_of_value(source_detacher&, const basic_value<TC>&);
+template<typename TC>
+void detach_regions_of_value(source_detacher&, basic_value<TC>&);
+
+// true unless TC defines `static constexpr bool track_location = false;`.
+template<typename T, typename U = void>
+struct tracks_location: std::true_type{};
+template<typename T>
+struct tracks_location<T, cxx::void_t<decltype(T::track_location)>>
+    : std::integral_constant<bool, T::track_location>{};
+
 template<typename TC, value_t V>
 struct getter;
 
@@ -2036,9 +2048,10 @@ class basic_value
 
     // }}}
 
+    // an empty source_location if TC::track_location is false.
     source_location location() const
     {
-        return source_location(this->region_);
+        return source_location(this->region_.get());
     }
 
     comment_type const& comments() const noexcept {return this->comments_;}
@@ -2107,6 +2120,10 @@ class basic_value
 
     template<typename TC>
     friend void detail::change_region_of_value(basic_value<TC>&, const basic_value<TC>&);
+    template<typename TC>
+    friend void detail::add_regions_of_value(detail::source_detacher&, const basic_value<TC>&);
+    template<typename TC>
+    friend void detail::detach_regions_of_value(detail::source_detacher&, basic_value<TC>&);
 
     template<typename TC>
     friend class basic_value;
@@ -2149,7 +2166,7 @@ class basic_value
         array_storage           array_;
         table_storage           table_;
     };
-    region_type  region_;
+    detail::value_region<detail::tracks_location<config_type>::value> region_;
     comment_type comments_;
 
 #ifdef TOML11_ENABLE_ACCESS_CHECK
@@ -2461,7 +2478,50 @@ TOML11_DETAIL_GENERATE_COMPTIME_GETTER(table          )
 template<typename TC>
 void change_region_of_value(basic_value<TC>& dst, const basic_value<TC>& src)
 {
-    dst.region_ = std::move(src.region_);
+    dst.region_ = src.region_;
+    return;
+}
+
+template<typename TC>
+void add_regions_of_value(source_detacher& detacher, const basic_value<TC>& v)
+{
+    detacher.add(v.region_.get());
+    // not via as_array/as_table, not to mark them as accessed
+    if(v.type_ == value_t::array)
+    {
+        for(const auto& elem : v.array_.value.get())
+        {
+            add_regions_of_value(detacher, elem);
+        }
+    }
+    else if(v.type_ == value_t::table)
+    {
+        for(const auto& kv : v.table_.value.get())
+        {
+            add_regions_of_value(detacher, kv.second);
+        }
+    }
+    return;
+}
+
+template<typename TC>
+void detach_regions_of_value(source_detacher& detacher, basic_value<TC>& v)
+{
+    v.region_ = detacher.detach(v.region_.get());
+    if(v.type_ == value_t::array)
+    {
+        for(auto& elem : v.array_.value.get())
+        {
+            detach_regions_of_value(detacher, elem);
+        }
+    }
+    else if(v.type_ == value_t::table)
+    {
+        for(auto& kv : v.table_.value.get())
+        {
+            detach_regions_of_value(detacher, kv.second);
+        }
+    }
     return;
 }
 
@@ -2508,6 +2568,36 @@ void unset_access_flag_recursively(basic_value<TC>& v)
 #endif
 
 } // namespace detail
+
+// What detach_source keeps of the sources.
+enum class detach_mode : std::uint8_t
+{
+    keep_lines,        // the lines shown in error messages
+    line_numbers_only, // only the line and column numbers
+    keep_source,       // everything; the sources are not released
+};
+
+// Releases the sources that `v` and its elements were parsed from. By default,
+// the lines they are defined on are copied, so that `location()` and error
+// messages stay the same. With `line_numbers_only`, only the positions of the
+// newlines are kept; the line and column numbers stay the same, but error
+// messages show empty lines. With `keep_source`, it does nothing. Values
+// copied from `v` before calling this keep the sources.
+template<typename TC>
+void detach_source(basic_value<TC>& v,
+                   const detach_mode mode = detach_mode::keep_lines)
+{
+    if( ! detail::tracks_location<TC>::value || mode == detach_mode::keep_source)
+    {
+        return;
+    }
+
+    detail::source_detacher detacher(mode == detach_mode::keep_lines);
+    detail::add_regions_of_value(detacher, v);
+    detail::detach_regions_of_value(detacher, v);
+    return;
+}
+
 } // TOML11_INLINE_VERSION_NAMESPACE
 } // namespace toml
 #endif // TOML11_VALUE_HPP
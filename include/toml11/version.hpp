@@ -102,6 +102,14 @@
 #  endif
 #endif
 
+#ifndef TOML11_DISABLE_MMAP
+#  if defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))
+#    if __has_include(<sys/mman.h>)
+#      define TOML11_HAS_MMAP 1
+#    endif
+#  endif
+#endif
+
 #if defined(TOML11_COMPILE_SOURCES)
 #  define TOML11_INLINE
 #else
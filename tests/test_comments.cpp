@@ -19,3 +19,106 @@ TEST_CASE("testing comments on simple value")
     CHECK_EQ(a.comments().at(1), "# comment 2");
     CHECK_EQ(a.comments().at(2), "# comment 3");
 }
+
+namespace
+{
+struct discard_type_config : toml::type_config
+{
+    using comment_type = toml::discard_comments;
+};
+} // anonymous
+
+TEST_CASE("testing comments with discard_comments")
+{
+    const std::string str(R"(# top-level comment
+
+# comment on a
+a = [ # after [
+    1, # after 1
+    # before 2
+    2
+] # after ]
+
+# comment on table
+[t] # after [t]
+b = {c = 3} # after b
+
+# comment on array of tables
+[[aot]] # after [[aot]]
+d = "e" # after d
+)");
+
+    const auto preserved = toml::parse_str(str);
+    const auto discarded = toml::parse_str<discard_type_config>(str);
+
+    CHECK_EQ(preserved.at("a").comments().size(), 2);
+    CHECK_EQ(preserved.at("aot").at(0).comments().size(), 2);
+
+    CHECK_UNARY(discarded.comments().empty());
+    CHECK_UNARY(discarded.at("a").comments().empty());
+    CHECK_UNARY(discarded.at("a").at(0).comments().empty());
+    CHECK_UNARY(discarded.at("t").comments().empty());
+    CHECK_UNARY(discarded.at("aot").at(0).comments().empty());
+    CHECK_UNARY(discarded.at("aot").at(0).at("d").comments().empty());
+
+    CHECK_EQ(discarded.at("a").at(1).as_integer(), 2);
+    CHECK_EQ(discarded.at("t").at("b").at("c").as_integer(), 3);
+    CHECK_EQ(discarded.at("aot").at(0).at("d").as_string(), "e");
+
+    // comments are still checked even if they are discarded
+    const auto res = toml::try_parse_str<discard_type_config>("a = 1 # \x01\n");
+    CHECK_UNARY(res.is_err());
+}
+
+TEST_CASE("testing preserve_comments without comments")
+{
+    static_assert(sizeof(toml::preserve_comments) == sizeof(void*), "");
+
+    toml::preserve_comments com;
+    CHECK_UNARY(com.empty());
+    CHECK_EQ(com.size(), 0);
+    CHECK_EQ(com.capacity(), 0);
+    CHECK_UNARY(com.begin() == com.end());
+    CHECK_UNARY(com.rbegin() == com.rend());
+    CHECK_UNARY(com.data() == nullptr);
+    CHECK_THROWS_AS(com.at(0), std::out_of_range);
+    CHECK_EQ(com, toml::preserve_comments(std::vector<std::string>{}));
+    CHECK_UNARY(com.erase(com.begin(), com.end()) == com.end());
+    com.clear();
+    com.resize(0);
+    CHECK_UNARY(com.empty());
+
+    // inserting into an empty one
+    const auto iter = com.insert(com.begin(), "# b");
+    CHECK_EQ(*iter, "# b");
+    com.insert(com.begin(), "# a");
+    com.push_back("# c");
+    CHECK_EQ(com, toml::preserve_comments({"# a", "# b", "# c"}));
+    CHECK_NE(com, toml::preserve_comments{});
+
+    toml::preserve_comments emplaced;
+    emplaced.emplace(emplaced.cend(), "# x");
+    CHECK_EQ(emplaced.size(), 1);
+    CHECK_EQ(emplaced.front(), "# x");
+
+    // copying and moving
+    auto copied = com;
+    CHECK_EQ(copied, com);
+    copied = toml::preserve_comments{};
+    CHECK_UNARY(copied.empty());
+    CHECK_EQ(com.size(), 3);
+
+    auto moved = std::move(com);
+    CHECK_EQ(moved.size(), 3);
+
+    std::vector<std::string> vec;
+    swap(moved, vec);
+    CHECK_UNARY(moved.empty());
+    CHECK_EQ(vec.size(), 3);
+
+    toml::preserve_comments none;
+    std::vector<std::string> other{"# y"};
+    swap(other, none);
+    CHECK_EQ(none.size(), 1);
+    CHECK_UNARY(other.empty());
+}
@@ -77,3 +77,35 @@ TEST_CASE("testing custom error message using source_location and value")
     CHECK_EQ(err.locations().at(1).second, "upper limit is defined here");
     CHECK_EQ(err.locations().at(2).second, "this is not in the range"   );
 }
+
+TEST_CASE("testing error message at EOF without newline")
+{
+    // {input, column just after the last char}
+    const std::vector<std::pair<std::string, std::size_t>> inputs = {
+        {"a = \"x", 7},
+        {"[a",      3},
+        {"a = [",   6},
+        {"a = ",    5},
+    };
+    for(const auto& input : inputs)
+    {
+        const auto res = toml::try_parse_str(input.first);
+        REQUIRE_UNARY(res.is_err());
+
+        const auto& loc = res.unwrap_err().at(0).locations().at(0).first;
+        CHECK_EQ(loc.first_line_number(),   1);
+        CHECK_EQ(loc.first_column_number(), input.second);
+        CHECK_EQ(loc.length(),              1);
+        CHECK_EQ(loc.first_line(),          input.first);
+
+        // the caret is put just after the last char
+        const std::string caret = "   | " + std::string(input.second - 1, ' ') + "^--";
+        CHECK_NE(toml::format_error(res.unwrap_err().at(0)).find(caret), std::string::npos);
+
+        // with a newline, it points the newline at the same column
+        const auto with_lf = toml::try_parse_str(input.first + "\n");
+        REQUIRE_UNARY(with_lf.is_err());
+        CHECK_EQ(with_lf.unwrap_err().at(0).locations().at(0).first.first_column_number(),
+                 input.second);
+    }
+}
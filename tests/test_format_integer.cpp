@@ -109,3 +109,88 @@ TEST_CASE("testing decimal with suffix")
     CHECK_EQ(   "1234_kcal", toml::format(toml::value(     1234, decimal_fmt(0, 0, "kcal")), sp));
     CHECK_EQ("1_2_3_4_μm",   toml::format(toml::value(     1234, decimal_fmt(4, 1, "μm")),   sp));
 }
+
+TEST_CASE("testing number_suffix")
+{
+    static_assert(sizeof(toml::number_suffix) == sizeof(void*), "");
+    static_assert(sizeof(toml::integer_format_info) <= 4 * sizeof(std::size_t), "");
+
+    toml::number_suffix none;
+    CHECK_UNARY(none.empty());
+    CHECK_EQ(none.size(), 0);
+    CHECK_EQ(none, "");
+    CHECK_EQ(none, toml::number_suffix(std::string("")));
+    CHECK_UNARY(toml::number_suffix("").empty());
+
+    toml::number_suffix sec("sec");
+    CHECK_UNARY( ! sec.empty());
+    CHECK_EQ(sec.size(), 3);
+    CHECK_EQ(sec, "sec");
+    CHECK_EQ(sec, std::string("sec"));
+    CHECK_EQ(std::string("sec"), sec);
+    CHECK_NE(sec, none);
+
+    const std::string str = sec;
+    CHECK_EQ(str, "sec");
+
+    auto copied = sec;
+    CHECK_EQ(copied, sec);
+    copied = none;
+    CHECK_UNARY(copied.empty());
+    CHECK_EQ(sec, "sec");
+
+    // the common members of std::string
+    CHECK_EQ(std::string(sec.c_str()), "sec");
+    CHECK_EQ(std::string(none.c_str()), "");
+    CHECK_EQ(std::string(sec.begin(), sec.end()), "sec");
+    CHECK_UNARY(none.begin() == none.end());
+    CHECK_EQ(sec.substr(1), "ec");
+    CHECK_EQ(sec[0], 's');
+    CHECK_EQ(sec.length(), 3);
+
+    toml::number_suffix unit;
+    unit += "k";
+    unit.append(std::string("m")) += '/';
+    unit += std::string("h");
+    CHECK_EQ(unit, "km/h");
+    unit += "";
+    CHECK_EQ(unit.size(), 4);
+    unit.clear();
+    CHECK_UNARY(unit.empty());
+
+    // modifiers of std::string
+    toml::number_suffix m;
+    m.push_back('m');
+    m.insert(0, "k");
+    m.insert(2, 1, '/');
+    m.push_back('s');
+    CHECK_EQ(m, "km/s");
+    m[3] = 'h';
+    CHECK_EQ(m, "km/h");
+    m.erase(2);
+    CHECK_EQ(m, "km");
+    m.pop_back();
+    m.resize(3, 'g');
+    CHECK_EQ(m, "kgg");
+    m.resize(2);
+    CHECK_EQ(m, "kg");
+
+    std::string& ref = m;
+    ref += "f";
+    CHECK_EQ(m, "kgf");
+
+    // binding a reference to an empty suffix does not make it non-empty
+    toml::number_suffix e;
+    std::string& eref = e;
+    CHECK_UNARY(eref.empty());
+    CHECK_UNARY(e.empty());
+    CHECK_EQ(e, none);
+    CHECK_UNARY(toml::number_suffix(e).empty());
+
+    toml::spec sp = toml::spec::v(1,0,0);
+    sp.ext_num_suffix = true;
+    const auto v = toml::parse_str("a = 42_sec\nb = 42\n", sp);
+    CHECK_EQ(v.at("a").as_integer_fmt().suffix, "sec");
+    CHECK_UNARY(v.at("b").as_integer_fmt().suffix.empty());
+    CHECK_EQ(toml::format(v.at("a"), sp), "42_sec");
+}
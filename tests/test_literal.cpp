@@ -118,5 +118,7 @@ TEST_CASE("testing toml value literal")
             toml::local_time(7, 32, 0),
             toml::time_offset(0, 0)));
     }
-
+    {
+        CHECK_THROWS_AS("a = \"\xC3\""_toml, toml::syntax_error);
+    }
 }
@@ -2,6 +2,7 @@
 #include "doctest.h"
 
 #include <toml11/location.hpp>
+#include <toml11/region.hpp>
 
 TEST_CASE("testing location")
 {
@@ -61,3 +62,338 @@ TEST_CASE("testing multiline location")
     CHECK_EQ(loc.line_number(), 2);
     CHECK_EQ(loc.column_number(), 5);
 }
+
+TEST_CASE("testing line and column numbers of location")
+{
+    std::string str;
+    for(int i=0; i<10; ++i)
+    {
+        str += std::string(static_cast<std::size_t>(i * 7), 'x') + "\n";
+    }
+    str += "0123456789";
+
+    // counted one by one
+    std::vector<std::size_t> lines, columns;
+    std::size_t line = 1, column = 1;
+    for(const char c : str)
+    {
+        lines  .push_back(line);
+        columns.push_back(column);
+        if(c == '\n') {line += 1; column = 1;} else {column += 1;}
+    }
+    lines  .push_back(line);
+    columns.push_back(column);
+
+    const auto first = toml::detail::make_temporary_location(str);
+    auto loc = first;
+    for(std::size_t n=0; n<=str.size(); ++n)
+    {
+        CHECK_EQ(loc.get_location(),  n);
+        CHECK_EQ(loc.line_number(),   lines.at(n));
+        CHECK_EQ(loc.column_number(), columns.at(n));
+
+        const toml::detail::region reg(first, loc);
+        if(n != 0)
+        {
+            CHECK_EQ(reg.last_line_number(),   lines.at(n));
+            CHECK_EQ(reg.last_column_number(), columns.at(n));
+        }
+        loc.advance();
+    }
+    for(std::size_t n=str.size(); n!=0; --n)
+    {
+        loc.retrace();
+        CHECK_EQ(loc.get_location(),  n - 1);
+        CHECK_EQ(loc.line_number(),   lines.at(n - 1));
+        CHECK_EQ(loc.column_number(), columns.at(n - 1));
+    }
+}
+
+TEST_CASE("testing cursor")
+{
+    auto loc = toml::detail::make_temporary_location("a = 1\nb = [\n  2,\n]\n");
+    loc.advance(4);
+
+    const auto first = loc.get_cursor();
+    const auto saved = loc;
+    loc.advance(9);
+
+    const toml::detail::region with_cursor(first, loc);
+    const toml::detail::region with_location(saved, loc);
+    CHECK_EQ(with_cursor.as_string(),          with_location.as_string());
+    CHECK_EQ(with_cursor.first_line_number(),  with_location.first_line_number());
+    CHECK_EQ(with_cursor.first_column_number(), with_location.first_column_number());
+    CHECK_EQ(with_cursor.last_line_number(),   with_location.last_line_number());
+    CHECK_EQ(with_cursor.last_column_number(), with_location.last_column_number());
+
+    CHECK_EQ(toml::detail::location(loc, first), saved);
+
+    loc.reset(first);
+    CHECK_EQ(loc, saved);
+    CHECK_EQ(loc.line_number(),   saved.line_number());
+    CHECK_EQ(loc.column_number(), saved.column_number());
+}
+
+TEST_CASE("testing line index of source buffer")
+{
+    // long lines, empty lines, and no LF at the end
+    const std::string str = "a = 1\n\n" + std::string(100, 'x') + "\n\nb = \"c\"";
+
+    const auto loc = toml::detail::make_temporary_location(str);
+    const auto& src = *loc.source();
+    CHECK_EQ(src.newlines(), std::vector<std::size_t>{5, 6, 107, 108});
+
+    std::size_t line = 1;
+    std::size_t line_begin = 0;
+    for(std::size_t i=0; i<=str.size(); ++i)
+    {
+        const auto line_end = (std::min)(str.find('\n', i), str.size());
+        CHECK_EQ(src.line_number(i), line);
+        CHECK_EQ(src.line_begin(i),  line_begin);
+        CHECK_EQ(src.line_end(i),    line_end);
+
+        auto l = loc;
+        l.advance(i);
+        CHECK_EQ(l.get_line(), str.substr(line_begin, line_end - line_begin));
+
+        if(i < str.size() && str.at(i) == '\n')
+        {
+            line += 1;
+            line_begin = i + 1;
+        }
+    }
+}
+
+TEST_CASE("testing token_view of region")
+{
+    auto loc = toml::detail::make_temporary_location("key = 1_000 # comment");
+    const auto first = loc;
+    loc.advance(3);
+    const toml::detail::region reg(first, loc);
+
+    const auto view = reg.as_view();
+    CHECK_EQ(view.size(), 3);
+    CHECK_UNARY(view == "key");
+    CHECK_UNARY(view != "ke");
+    CHECK_UNARY(view != "keys");
+    CHECK_EQ(view.as_string(), "key");
+    CHECK_EQ(reg.as_string(),  "key");
+
+    const toml::detail::region whole(first, [&]{auto l = first; l.advance(11); return l;}());
+    const auto num = whole.as_view().substr(6);
+    CHECK_EQ(num.as_string(), "1_000");
+    CHECK_EQ(num.rfind('_'), 1);
+    CHECK_UNARY(num.rfind('x') == toml::detail::token_view::npos);
+    CHECK_EQ(num.substr(2, 100).as_string(), "000");
+    CHECK_UNARY(num.substr(5).empty());
+
+    CHECK_UNARY(toml::detail::region().as_view().empty());
+    CHECK_EQ(toml::detail::region().as_string(), "");
+}
+
+TEST_CASE("testing compact region")
+{
+    static_assert(sizeof(toml::detail::region) <= 3 * sizeof(std::size_t), "");
+
+    auto loc = toml::detail::make_temporary_location("a = 1\nb = 2\n");
+    const auto first = loc;
+    loc.advance(5); // LF at the end of the first line
+
+    const toml::detail::region at_lf(loc);
+    CHECK_EQ(at_lf.length(), 1);
+    CHECK_EQ(at_lf.as_string(), "\n");
+    CHECK_EQ(at_lf.first_line_number(),   1);
+    CHECK_EQ(at_lf.first_column_number(), 6);
+    CHECK_EQ(at_lf.last_line_number(),    1);
+    CHECK_EQ(at_lf.last_column_number(),  7);
+
+    const toml::detail::region line(first, toml::detail::next(loc));
+    CHECK_EQ(line.length(), 6);
+    CHECK_EQ(line.last_line_number(),     2);
+    CHECK_EQ(line.last_column_number(),   1);
+
+    // at EOF after the last LF, it points the LF and ends on the next line
+    loc.advance(100);
+    REQUIRE_UNARY(loc.eof());
+    const toml::detail::region at_eof(loc);
+    CHECK_EQ(at_eof.as_string(), "\n");
+    CHECK_EQ(at_eof.first_line_number(), 2);
+    CHECK_EQ(at_eof.last_line_number(),  3);
+
+    // at EOF without LF, it points the column after the last char
+    auto no_lf = toml::detail::make_temporary_location("a = 1");
+    no_lf.advance(100);
+    const toml::detail::region after_last(no_lf);
+    CHECK_EQ(after_last.length(), 1);
+    CHECK_EQ(after_last.as_string(), "");
+    CHECK_UNARY(after_last.begin() == after_last.end());
+    CHECK_EQ(after_last.first_line_number(),   1);
+    CHECK_EQ(after_last.first_column_number(), 6);
+    CHECK_EQ(after_last.last_line_number(),    1);
+    CHECK_EQ(after_last.last_column_number(),  7);
+    CHECK_EQ(after_last.as_lines().size(), 1);
+    CHECK_EQ(after_last.as_lines().at(0).first,  "a = 1");
+    CHECK_EQ(after_last.as_lines().at(0).second, 5);
+
+    // the name is shared, not copied
+    CHECK_EQ(std::addressof(at_lf.source_name()), std::addressof(at_eof.source_name()));
+    CHECK_EQ(std::addressof(at_lf.source_name()), std::addressof(first.source_name()));
+
+    const toml::detail::region none;
+    CHECK_UNARY( ! none.is_ok());
+    CHECK_EQ(none.source_name(), "");
+    CHECK_EQ(none.first_line_number(), 0);
+}
+
+TEST_CASE("testing source_detacher")
+{
+    const std::string str = "# a comment that is long enough to be omitted from the lines\n"
+        "a = [\n  1,\n  2,\n]\n\n# another comment that is long enough to be omitted\n"
+        "b = 'a string that is long enough to be capped in error messages'";
+
+    const auto check_same = [](const toml::detail::region& reg,
+                               const toml::detail::region& det) {
+        CHECK_EQ(reg.is_ok(),               det.is_ok());
+        CHECK_EQ(reg.source_name(),         det.source_name());
+        CHECK_EQ(reg.length(),              det.length());
+        CHECK_EQ(reg.first_line_number(),   det.first_line_number());
+        CHECK_EQ(reg.first_column_number(), det.first_column_number());
+        CHECK_EQ(reg.last_line_number(),    det.last_line_number());
+        CHECK_EQ(reg.last_column_number(),  det.last_column_number());
+        CHECK_EQ(reg.as_lines(),            det.as_lines());
+    };
+
+    // any region looks the same after it is detached alone
+    const auto loc = toml::detail::make_temporary_location(str);
+    for(std::size_t i=0; i<=str.size(); ++i)
+    {
+        auto first = loc;
+        first.advance(i);
+        {
+            const toml::detail::region reg(first);
+            toml::detail::source_detacher detacher;
+            detacher.add(reg);
+            check_same(reg, detacher.detach(reg));
+        }
+        for(std::size_t j=i; j<=str.size(); ++j)
+        {
+            auto last = first;
+            last.advance(j - i);
+            const toml::detail::region reg(first, last);
+            toml::detail::source_detacher detacher;
+            detacher.add(reg);
+            const auto det = detacher.detach(reg);
+            check_same(reg, det);
+            CHECK_EQ(reg.as_string(), det.as_string());
+        }
+    }
+
+    // the lines that no region needs are dropped, and the regions share the
+    // new source
+    auto src_loc = toml::detail::make_temporary_location(str);
+    const auto region_at = [&src_loc](const std::size_t first, const std::size_t len) {
+        auto f = src_loc; f.advance(first);
+        auto l = f;       l.advance(len);
+        return toml::detail::region(f, l);
+    };
+    std::vector<toml::detail::region> regions;
+    regions.push_back(region_at( 69, 1)); // 1
+    regions.push_back(region_at(132, 5)); // b = '
+
+    toml::detail::source_detacher detacher;
+    for(const auto& reg : regions)
+    {
+        detacher.add(reg);
+    }
+    std::vector<toml::detail::region> detached;
+    for(const auto& reg : regions)
+    {
+        detached.push_back(detacher.detach(reg));
+        check_same(reg, detached.back());
+    }
+    CHECK_EQ(detached.at(0).as_string(), "1");
+    CHECK_EQ(detached.at(1).as_string(), "b = '");
+
+    const auto& src = detached.at(0).source();
+    CHECK_EQ(detached.at(1).source(), src);
+    CHECK_EQ(std::string(src->begin(), src->end()),
+             "\n\n  1,\n\n\n\n\n" + str.substr(132));
+
+    // the original source is released with the original regions
+    std::weak_ptr<const toml::detail::source_buffer> original = src_loc.source();
+    regions.clear();
+    detacher = toml::detail::source_detacher{};
+    src_loc  = toml::detail::make_temporary_location("");
+    CHECK_UNARY(original.expired());
+    CHECK_EQ(detached.at(1).first_line_number(), 8);
+}
+
+TEST_CASE("testing source_detacher without the text")
+{
+    // every line has a value, so keep_lines keeps almost all the text
+    std::string str;
+    for(int i=0; i<100; ++i)
+    {
+        const auto n = std::to_string(i);
+        str += "[server_" + n + "]\n";
+        str += "host = \"host-" + n + ".example.com\" # where to connect\n";
+        str += "port = 8080\n";
+        str += "tags = [\"primary\", \"east\"]\n\n";
+    }
+    const auto first = toml::detail::make_temporary_location(str);
+
+    std::vector<toml::detail::region> regs;
+    for(std::size_t i = 0; i < str.size(); i = str.find('\n', i) + 1)
+    {
+        const auto eol = str.find('\n', i);
+        const auto eq  = str.find(" = ", i);
+        if(eol == i) {continue;}
+        auto b = first; b.advance(eq < eol ? eq + 3 : i);
+        auto e = first; e.advance(eol);
+        regs.emplace_back(b, e);
+    }
+
+    const auto footprint = [](const toml::detail::region& r) -> std::size_t {
+        const auto& src = *r.source();
+        return (src.has_text() ? src.size() : 0) +
+               src.newlines().size() * sizeof(std::size_t);
+    };
+
+    toml::detail::source_detacher with_lines;
+    toml::detail::source_detacher numbers_only(false);
+    for(const auto& r : regs)
+    {
+        with_lines.add(r);
+        numbers_only.add(r);
+    }
+    for(const auto& r : regs)
+    {
+        const auto l = with_lines.detach(r);
+        const auto n = numbers_only.detach(r);
+
+        CHECK_EQ(l.as_string(), r.as_string());
+        CHECK_EQ(l.as_lines(),  r.as_lines());
+
+        CHECK_UNARY( ! n.source()->has_text());
+        CHECK_UNARY(n.as_view().empty());
+        CHECK_UNARY(n.begin() == n.end());
+        CHECK_EQ(n.length(),              r.length());
+        CHECK_EQ(n.first_line_number(),   r.first_line_number());
+        CHECK_EQ(n.first_column_number(), r.first_column_number());
+        CHECK_EQ(n.last_line_number(),    r.last_line_number());
+        CHECK_EQ(n.last_column_number(),  r.last_column_number());
+        CHECK_EQ(n.as_lines().size(), 1);
+        CHECK_EQ(n.as_lines().at(0).first,  "");
+        CHECK_EQ(n.as_lines().at(0).second, r.first_column_number() - 1);
+    }
+
+    const auto original = footprint(regs.front());
+    CHECK_UNARY(footprint(with_lines  .detach(regs.front())) * 10 > original * 9);
+    CHECK_UNARY(footprint(numbers_only.detach(regs.front())) * 3  < original);
+
+    // the text is already dropped, so it does not make a copy
+    toml::detail::source_detacher again;
+    const auto n = numbers_only.detach(regs.front());
+    again.add(n);
+    CHECK_EQ(again.detach(n).source(), n.source());
+}
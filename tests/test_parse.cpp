@@ -3,7 +3,12 @@
 
 #include <toml.hpp>
 
+#include <chrono>
 #include <clocale>
+#include <cstdio>
+#include <limits>
+#include <sstream>
+#include <streambuf>
 
 TEST_CASE("testing toml::parse(file)")
 {
@@ -48,3 +53,548 @@ role = "backend"
     CHECK_EQ(toml::find<int>(v, "database", "ports", 1), 8001);
     CHECK_EQ(toml::find<int>(v, "database", "ports", 2), 8002);
 }
+
+namespace
+{
+// a streambuf that does not support seeking, like a pipe
+struct non_seekable_buf final : public std::streambuf
+{
+    explicit non_seekable_buf(std::string str)
+        : str_(std::move(str)), pos_(0)
+    {}
+
+  protected:
+
+    int_type underflow() override
+    {
+        if(str_.size() <= pos_)
+        {
+            return traits_type::eof();
+        }
+        // pass a small chunk at a time
+        const std::size_t len = (std::min)(std::size_t(100), str_.size() - pos_);
+        char* first = &str_[pos_];
+        this->setg(first, first, first + len);
+        pos_ += len;
+        return traits_type::to_int_type(*first);
+    }
+
+  private:
+    std::string str_;
+    std::size_t pos_;
+};
+} // anonymous
+
+TEST_CASE("testing toml::parse(istream / FILE*) without seeking")
+{
+    std::string content("title = \"chunked\"\n");
+    for(std::size_t i=0; i<5000; ++i)
+    {
+        content += "key" + std::to_string(i) + " = " + std::to_string(i) + "\n";
+    }
+    const auto ref = toml::parse_str(content);
+    CHECK_EQ(toml::find<int>(ref, "key4999"), 4999);
+
+    {
+        non_seekable_buf buf(content);
+        std::istream is(&buf);
+        CHECK_EQ(is.tellg(), std::istream::pos_type(-1));
+        CHECK_EQ(toml::parse(is, "non-seekable"), ref);
+    }
+    {
+        non_seekable_buf buf(content);
+        std::istream is(&buf);
+        const auto res = toml::try_parse(is, "non-seekable");
+        REQUIRE_UNARY(res.is_ok());
+        CHECK_EQ(res.unwrap(), ref);
+    }
+    {
+        // it reads the rest of the stream
+        std::istringstream iss("# skipped\n" + content);
+        std::string line;
+        std::getline(iss, line);
+        CHECK_EQ(toml::parse(iss, "istringstream"), ref);
+    }
+
+    {
+        std::ofstream ofs("test_parse_chunked.toml", std::ios_base::binary);
+        ofs << "# skipped\n" << content;
+    }
+    {
+        FILE* fp = std::fopen("test_parse_chunked.toml", "rb");
+        REQUIRE_UNARY(fp != nullptr);
+        char line[16];
+        CHECK_UNARY(std::fgets(line, sizeof(line), fp) != nullptr);
+        CHECK_EQ(toml::parse(fp, "test_parse_chunked.toml"), ref);
+        std::fclose(fp);
+    }
+#if defined(__unix__) || defined(__APPLE__)
+    {
+        FILE* fp = ::popen("cat test_parse_chunked.toml", "r");
+        REQUIRE_UNARY(fp != nullptr);
+        const auto res = toml::try_parse(fp, "pipe");
+        ::pclose(fp);
+        REQUIRE_UNARY(res.is_ok());
+        CHECK_EQ(res.unwrap().as_table().size(), ref.as_table().size());
+        CHECK_EQ(toml::find<int>(res.unwrap(), "key4999"), 4999);
+        CHECK_EQ(res.unwrap().at("title").comments().size(), 1);
+    }
+#endif
+}
+
+TEST_CASE("testing toml::parse_view")
+{
+    // a part of a larger buffer. It does not end with a newline.
+    const std::string buffer("a = 42\n[tab]\nb = \"foo\" # comment\nc = [1, 2]GARBAGE");
+    const std::size_t len = buffer.size() - 7;
+
+    const auto v = toml::parse_view(buffer.data(), len, "buffer");
+    CHECK_EQ(v, toml::parse_str(buffer.substr(0, len)));
+    CHECK_EQ(toml::find<int>(v, "a"), 42);
+    CHECK_EQ(toml::find<std::string>(v, "tab", "b"), "foo");
+    CHECK_EQ(v.at("tab").at("b").comments().size(), 1);
+    CHECK_EQ(v.at("tab").at("c").location().file_name(), "buffer");
+    CHECK_EQ(v.at("tab").at("c").location().first_line(), "c = [1, 2]");
+
+    // the last comment line without a newline
+    const std::string comment("a = 42\n# comment");
+    CHECK_EQ(toml::parse_view(comment.data(), comment.size()), toml::parse_str("a = 42"));
+
+    const std::string empty("");
+    CHECK_EQ(toml::parse_view(empty.data(), empty.size()), toml::value(toml::table{}));
+
+    CHECK_UNARY(toml::try_parse_view(buffer.data(), buffer.size()).is_err());
+    CHECK_THROWS_AS(toml::parse_view(buffer.data(), buffer.size()), toml::syntax_error);
+
+    // a lone CR at the end is not a newline
+    const std::string cr("a = 42\r");
+    CHECK_UNARY(toml::try_parse_view(cr.data(), cr.size()).is_err());
+
+#if defined(TOML11_HAS_STRING_VIEW)
+    const std::string_view sv(buffer.data(), len);
+    CHECK_EQ(toml::parse_view(sv, "buffer"), v);
+#endif
+
+    // the values do not refer to the buffer after returning
+    toml::value w;
+    {
+        std::string tmp(buffer.data(), len);
+        w = toml::parse_view(tmp.data(), tmp.size(), "buffer");
+        tmp.assign(tmp.size(), 'X');
+    }
+    CHECK_EQ(w, v);
+    CHECK_EQ(w.at("tab").at("c").location().first_line(), "c = [1, 2]");
+    CHECK_EQ(toml::format_error("error", w.at("tab").at("b"), "here"),
+             toml::format_error("error", v.at("tab").at("b"), "here"));
+
+    // keep_source does not copy anything. the values refer to the buffer.
+    std::string buf(buffer.data(), len);
+    const auto kept = toml::parse_view(buf.data(), buf.size(), "buffer",
+            toml::spec::default_version(), toml::detach_mode::keep_source);
+    CHECK_EQ(kept, v);
+    CHECK_EQ(kept.at("tab").at("c").location().first_line(), "c = [1, 2]");
+    buf.replace(buf.find("c = [1, 2]"), 10, "X = [1, 2]");
+    CHECK_EQ(kept.at("tab").at("c").location().first_line(), "X = [1, 2]");
+
+    // line_numbers_only keeps only the positions
+    const auto numbers = toml::parse_view(buf.data(), buf.size(), "buffer",
+            toml::spec::default_version(), toml::detach_mode::line_numbers_only);
+    CHECK_EQ(numbers.at("tab").at("b").location().first_line_number(), 3);
+    CHECK_EQ(numbers.at("tab").at("b").location().first_column_number(), 5);
+    CHECK_EQ(numbers.at("tab").at("b").location().first_line(), "");
+}
+
+TEST_CASE("testing toml::parse(file) with memory_map_file")
+{
+    const std::string content("a = 42\n[tab]\nb = \"foo\"\n");
+    {
+        std::ofstream ofs("test_parse_mmap.toml");
+        ofs << content;
+    }
+    {
+        // without the last newline
+        std::ofstream ofs("test_parse_mmap_nolf.toml");
+        ofs << "a = 42";
+    }
+    {
+        std::ofstream ofs("test_parse_mmap_err.toml");
+        ofs << "a = 42\nb = \"foo\n";
+    }
+
+    auto s = toml::spec::default_version();
+    s.memory_map_file = true;
+
+    toml::value v;
+    {
+        // a value must keep the mapping alive
+        v = toml::parse("test_parse_mmap.toml", s);
+    }
+    CHECK_EQ(v, toml::parse_str(content));
+    CHECK_EQ(toml::find<std::string>(v, "tab", "b"), "foo");
+    CHECK_EQ(v.at("tab").at("b").location().first_line_number(), 3);
+    CHECK_EQ(v.at("tab").at("b").location().file_name(), "test_parse_mmap.toml");
+    CHECK_EQ(v.at("tab").at("b").location().first_line(), "b = \"foo\"");
+
+    CHECK_EQ(toml::parse("test_parse_mmap_nolf.toml", s), toml::parse_str("a = 42"));
+
+    CHECK_UNARY(toml::try_parse("test_parse_mmap.toml", s).is_ok());
+    CHECK_UNARY(toml::try_parse("test_parse_mmap_err.toml", s).is_err());
+    CHECK_THROWS_AS(toml::parse("test_parse_mmap_err.toml", s), toml::syntax_error);
+    CHECK_THROWS_AS(toml::parse("nonexistent.toml", s), toml::file_io_error);
+
+#if defined(TOML11_HAS_MMAP)
+    CHECK_UNARY(toml::detail::map_file("test_parse_mmap.toml") != nullptr);
+    // special files are not mapped. parse falls back to std::ifstream.
+    CHECK_UNARY(toml::detail::map_file("/dev/null") == nullptr);
+    CHECK_EQ(toml::parse("/dev/null", s), toml::value(toml::table{}));
+#endif
+}
+
+namespace
+{
+// parse_int/parse_float receive a region; the location is built on failure.
+struct region_type_config : toml::type_config
+{
+    static int called;
+
+    static toml::result<integer_type, toml::error_info>
+    parse_int(const std::string& str, const toml::detail::region& reg, const std::uint8_t base)
+    {
+        ++called;
+        return toml::read_int<integer_type>(str, reg, base);
+    }
+    static toml::result<floating_type, toml::error_info>
+    parse_float(const std::string& str, const toml::detail::region& reg, const bool is_hex)
+    {
+        ++called;
+        return toml::read_float<floating_type>(str, reg, is_hex);
+    }
+};
+int region_type_config::called = 0;
+
+// the signature before region was introduced.
+struct legacy_type_config
+{
+    using comment_type  = toml::preserve_comments;
+
+    using boolean_type  = bool;
+    using integer_type  = std::int64_t;
+    using floating_type = double;
+    using string_type   = std::string;
+
+    template<typename T>
+    using array_type = std::vector<T>;
+    template<typename K, typename T>
+    using table_type = std::unordered_map<K, T>;
+
+    static int called;
+
+    static toml::result<integer_type, toml::error_info>
+    parse_int(const std::string& str, const toml::source_location src, const std::uint8_t base)
+    {
+        ++called;
+        return toml::read_int<integer_type>(str, src, base);
+    }
+    static toml::result<floating_type, toml::error_info>
+    parse_float(const std::string& str, const toml::source_location src, const bool is_hex)
+    {
+        ++called;
+        return toml::read_float<floating_type>(str, src, is_hex);
+    }
+};
+int legacy_type_config::called = 0;
+} // anonymous
+
+namespace
+{
+// derives parse_int from type_config
+struct wo_comment_type_config : toml::type_config
+{
+    using comment_type = toml::discard_comments;
+};
+} // anonymous
+
+TEST_CASE("testing the parser reads integers by itself for the default parse_int")
+{
+    static_assert(toml::detail::has_default_parse_int<toml::type_config>::value, "");
+    static_assert(toml::detail::has_default_parse_int<toml::ordered_type_config>::value, "");
+    static_assert(toml::detail::has_default_parse_int<wo_comment_type_config>::value, "");
+    static_assert( ! toml::detail::has_default_parse_int<region_type_config>::value, "");
+    static_assert( ! toml::detail::has_default_parse_int<legacy_type_config>::value, "");
+
+    const auto v = toml::parse_str<wo_comment_type_config>(
+        "a = 1_000 # comment\nb = 0xDEAD_BEEF\nc = -9223372036854775808\n");
+    CHECK_EQ(v.at("a").as_integer(), 1000);
+    CHECK_EQ(v.at("a").as_integer_fmt().spacer, 3);
+    CHECK_EQ(v.at("b").as_integer(), 0xDEADBEEF);
+    CHECK_EQ(v.at("c").as_integer(), (std::numeric_limits<std::int64_t>::min)());
+    CHECK_UNARY(v.at("a").comments().empty());
+
+    CHECK_UNARY(toml::try_parse_str<wo_comment_type_config>("a = 9223372036854775808").is_err());
+}
+
+TEST_CASE("testing toml::parse with parse_int/parse_float taking region")
+{
+    static_assert(toml::detail::has_lazy_parse_int<toml::type_config>::value, "");
+    static_assert(toml::detail::has_lazy_parse_float<toml::ordered_type_config>::value, "");
+    static_assert(toml::detail::has_lazy_parse_int<region_type_config>::value, "");
+    static_assert( ! toml::detail::has_lazy_parse_int<legacy_type_config>::value, "");
+    static_assert( ! toml::detail::has_lazy_parse_float<legacy_type_config>::value, "");
+    static_assert(toml::detail::is_type_config<legacy_type_config>::value, "");
+
+    const std::string ok("a = 42\nb = 0xFF\nc = 3.14\n");
+    const std::string ng("a = 1\nb = 99999999999999999999\n");
+    {
+        region_type_config::called = 0;
+        const auto v = toml::parse_str<region_type_config>(ok);
+        CHECK_EQ(region_type_config::called, 3);
+        CHECK_EQ(v.at("a").as_integer(), 42);
+        CHECK_EQ(v.at("b").as_integer(), 255);
+        CHECK_EQ(v.at("c").as_floating(), 3.14);
+
+        const auto r = toml::try_parse_str<region_type_config>(ng);
+        REQUIRE_UNARY(r.is_err());
+        const auto msg = toml::format_error(r.as_err().at(0));
+        CHECK_NE(msg.find("99999999999999999999"), std::string::npos);
+        CHECK_NE(msg.find(" 2 | "), std::string::npos);
+    }
+    {
+        legacy_type_config::called = 0;
+        const auto v = toml::parse_str<legacy_type_config>(ok);
+        CHECK_EQ(legacy_type_config::called, 3);
+        CHECK_EQ(v.at("a").as_integer(), 42);
+        CHECK_EQ(v.at("b").as_integer(), 255);
+        CHECK_EQ(v.at("c").as_floating(), 3.14);
+
+        const auto r = toml::try_parse_str<legacy_type_config>(ng);
+        REQUIRE_UNARY(r.is_err());
+        const auto msg = toml::format_error(r.as_err().at(0));
+        CHECK_NE(msg.find("99999999999999999999"), std::string::npos);
+        CHECK_NE(msg.find(" 2 | "), std::string::npos);
+    }
+}
+
+TEST_CASE("testing toml::parse value type dispatch")
+{
+    const auto type_of = [](const std::string& str, const toml::spec& s) {
+        const auto r = toml::try_parse_str("a = " + str + "\nb = [" + str + ", " + str + "]\n", s);
+        REQUIRE_UNARY(r.is_ok());
+        CHECK_EQ(r.as_ok().at("b").at(1).type(), r.as_ok().at("a").type());
+        return r.as_ok().at("a").type();
+    };
+    const auto v10 = toml::spec::v(1, 0, 0);
+
+    CHECK_EQ(type_of("42",           v10), toml::value_t::integer);
+    CHECK_EQ(type_of("-1_000",       v10), toml::value_t::integer);
+    CHECK_EQ(type_of("0xDEAD_BEEF",  v10), toml::value_t::integer);
+    CHECK_EQ(type_of("0o755",        v10), toml::value_t::integer);
+    CHECK_EQ(type_of("0b1101",       v10), toml::value_t::integer);
+    CHECK_EQ(type_of("3.14",         v10), toml::value_t::floating);
+    CHECK_EQ(type_of("-1_0e-3",      v10), toml::value_t::floating);
+    CHECK_EQ(type_of("6E+2",         v10), toml::value_t::floating);
+    CHECK_EQ(type_of("+inf",         v10), toml::value_t::floating);
+    CHECK_EQ(type_of("-nan",         v10), toml::value_t::floating);
+    CHECK_EQ(type_of("1979-05-27",   v10), toml::value_t::local_date);
+    CHECK_EQ(type_of("07:32:00.999", v10), toml::value_t::local_time);
+    CHECK_EQ(type_of("1979-05-27T07:32:00",       v10), toml::value_t::local_datetime);
+    CHECK_EQ(type_of("1979-05-27 07:32:00.5",     v10), toml::value_t::local_datetime);
+    CHECK_EQ(type_of("1979-05-27T07:32:00Z",      v10), toml::value_t::offset_datetime);
+    CHECK_EQ(type_of("1979-05-27 07:32:00-07:00", v10), toml::value_t::offset_datetime);
+
+    auto ext = toml::spec::v(1, 1, 0);
+    ext.ext_hex_float  = true;
+    ext.ext_num_suffix = true;
+    CHECK_EQ(type_of("07:32",        ext), toml::value_t::local_time);
+    CHECK_EQ(type_of("0x1.8p3",      ext), toml::value_t::floating);
+    CHECK_EQ(type_of("1_000_mm",     ext), toml::value_t::integer);
+    CHECK_EQ(type_of("1.5_em",       ext), toml::value_t::floating);
+    CHECK_EQ(type_of("1e3_μm",       ext), toml::value_t::floating);
+
+    // malformed values are reported by the detailed checks
+    const auto error_of = [](const std::string& str) {
+        const auto r = toml::try_parse_str("a = " + str + "\n");
+        REQUIRE_UNARY(r.is_err());
+        return toml::format_error(r.as_err().at(0));
+    };
+    CHECK_NE(error_of("5E.9").find("bad float"), std::string::npos);
+    CHECK_NE(error_of("1.e5").find("bad float"), std::string::npos);
+    CHECK_NE(error_of("1e"  ).find("bad float"), std::string::npos);
+    CHECK_NE(error_of("01.5").find("bad integer"), std::string::npos);
+    CHECK_NE(error_of("0123").find("bad integer"), std::string::npos);
+    CHECK_NE(error_of("1979-05-27T7:32:00").find("bad time"), std::string::npos);
+    CHECK_NE(error_of("1979-05-27T07:32:00+9:00").find("bad offset"), std::string::npos);
+}
+
+TEST_CASE("testing toml::parse with invalid UTF-8")
+{
+    const auto r = toml::try_parse_str("a = 1\nb = \"\xC3\xA9\"\nc = \"\xC3\"\n");
+    REQUIRE_UNARY(r.is_err());
+    REQUIRE_EQ(r.as_err().size(), 1);
+    const auto& e = r.as_err().at(0);
+    CHECK_NE(e.title().find("invalid UTF-8"), std::string::npos);
+    REQUIRE_EQ(e.locations().size(), 1);
+    CHECK_EQ(e.locations().at(0).first.first_line_number(),   3);
+    CHECK_EQ(e.locations().at(0).first.first_column_number(), 6);
+
+    // also in a comment, where the scanner does not look into each byte
+    CHECK_UNARY(toml::try_parse_str("# " + std::string(100, 'a') + "\xFF\na = 1\n").is_err());
+    CHECK_UNARY(toml::try_parse_str("# \xE3\x81\x82\na = \"\xF0\x9F\x98\x80\"\n").is_ok());
+}
+
+TEST_CASE("testing toml::parse with a long line")
+{
+    // line and column numbers are computed only for the error, so the time
+    // does not depend on how long the lines are.
+    const auto single_line = [](const std::size_t size) {
+        const std::string elem = "\"" + std::string(1000, 'x') + "\", 1.5, 42, ";
+        std::string str = "a = [";
+        while(str.size() < size)
+        {
+            str += elem;
+        }
+        return str + "] x";
+    };
+    const auto elapsed = [](const std::string& str) {
+        double t = 1e10;
+        for(int i=0; i<3; ++i)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            const auto res   = toml::try_parse_str(str);
+            const auto stop  = std::chrono::steady_clock::now();
+            REQUIRE_UNARY(res.is_err());
+            // the error at the end of the line
+            CHECK_EQ(res.unwrap_err().at(0).locations().at(0).first.first_line_number(), 1);
+            CHECK_EQ(res.unwrap_err().at(0).locations().at(0).first.first_column_number(), str.size());
+            t = (std::min)(t, std::chrono::duration<double>(stop - start).count());
+        }
+        return t;
+    };
+    const auto t1  = elapsed(single_line( 1 * 1000 * 1000));
+    const auto t10 = elapsed(single_line(10 * 1000 * 1000));
+    CHECK_UNARY(t10 < 30.0 * t1 + 0.1);
+}
+
+namespace
+{
+struct untracked_type_config : toml::type_config
+{
+    static constexpr bool track_location = false;
+};
+} // anonymous
+
+TEST_CASE("testing toml::parse without tracking locations")
+{
+    static_assert( toml::detail::tracks_location<toml::type_config>::value, "");
+    static_assert( ! toml::detail::tracks_location<untracked_type_config>::value, "");
+    static_assert(sizeof(toml::basic_value<untracked_type_config>) < sizeof(toml::value), "");
+
+    const std::string str = "a = 1\n[t]\nb = [1, 2.0,\n  \"3\"]  \nc = {d = \"\"\"e\"\"\"}\n"
+                            "e = 1979-05-27T07:32:00Z\nf = 1979-05-27T07:32:00\n"
+                            "# comment\n[[aot]]\ng = '''\nx\n'''\n";
+
+    const auto tracked   = toml::parse_str(str);
+    const auto untracked = toml::parse_str<untracked_type_config>(str);
+    CHECK_EQ(toml::value(untracked), tracked);
+
+    CHECK_UNARY( ! untracked.location().is_ok());
+    CHECK_UNARY( ! untracked.at("a").location().is_ok());
+    CHECK_UNARY( ! untracked.at("t").at("b").location().is_ok());
+    CHECK_UNARY( ! untracked.at("t").at("b").at(2).location().is_ok());
+    CHECK_UNARY( ! untracked.at("t").at("c").location().is_ok());
+    CHECK_UNARY( ! untracked.at("t").at("e").location().is_ok());
+    CHECK_UNARY( ! untracked.at("aot").at(0).at("g").location().is_ok());
+
+    // a tracked value loses its location when converted to an untracked one
+    CHECK_UNARY(tracked.at("a").location().is_ok());
+    CHECK_UNARY( ! toml::basic_value<untracked_type_config>(tracked.at("a")).location().is_ok());
+
+    // syntax errors still point the input
+    const auto res = toml::try_parse_str<untracked_type_config>("a = 1\nb = \n");
+    REQUIRE_UNARY(res.is_err());
+    CHECK_NE(toml::format_error(res.unwrap_err().at(0)).find(" 2 | b = "), std::string::npos);
+
+    CHECK_UNARY(toml::try_parse_str<untracked_type_config>("a = 1\na = 2\n").is_err());
+}
+
+namespace
+{
+void check_same_locations(const toml::value& lhs, const toml::value& rhs)
+{
+    const auto l = lhs.location();
+    const auto r = rhs.location();
+    CHECK_EQ(l.is_ok(),               r.is_ok());
+    CHECK_EQ(l.file_name(),           r.file_name());
+    CHECK_EQ(l.first_line_number(),   r.first_line_number());
+    CHECK_EQ(l.first_column_number(), r.first_column_number());
+    CHECK_EQ(l.last_line_number(),    r.last_line_number());
+    CHECK_EQ(l.last_column_number(),  r.last_column_number());
+    CHECK_EQ(l.length(),              r.length());
+    CHECK_EQ(l.lines(),               r.lines());
+    CHECK_EQ(toml::format_error("error", lhs, "here"),
+             toml::format_error("error", rhs, "here"));
+
+    if(lhs.is_array())
+    {
+        for(std::size_t i=0; i<lhs.size(); ++i)
+        {
+            check_same_locations(lhs.at(i), rhs.at(i));
+        }
+    }
+    else if(lhs.is_table())
+    {
+        for(const auto& kv : lhs.as_table())
+        {
+            check_same_locations(kv.second, rhs.at(kv.first));
+        }
+    }
+}
+} // anonymous
+
+TEST_CASE("testing toml::detach_source")
+{
+    const std::string str = "# header\na = 1\n[t]\nb = [1, 2.0,\n  \"3\",\n\n  4]  \n"
+                            "c = {d = \"\"\"e\"\"\"}\n# comment\n[[aot]]\ng = '''\nx\n'''\n"
+                            "h = 'no newline at the end'";
+
+    const auto original = toml::parse_str(str);
+    auto detached = original;
+    toml::detach_source(detached);
+
+    CHECK_EQ(detached, original);
+    check_same_locations(detached, original);
+
+    // values built manually, or untracked ones, do not have any source
+    toml::value manual(toml::table{{"a", 1}});
+    toml::detach_source(manual);
+    CHECK_UNARY( ! manual.at("a").location().is_ok());
+
+    auto untracked = toml::parse_str<untracked_type_config>(str);
+    toml::detach_source(untracked);
+    CHECK_UNARY( ! untracked.at("a").location().is_ok());
+}
+
+TEST_CASE("testing toml::detach_source with line_numbers_only")
+{
+    const std::string str = "a = 1\n[t]\nb = [1, 2.0,\n  \"3\",\n  4]\n"
+                            "c = {d = \"\"\"e\"\"\"}\n";
+
+    const auto original = toml::parse_str(str);
+    auto detached = original;
+    toml::detach_source(detached, toml::detach_mode::line_numbers_only);
+    CHECK_EQ(detached, original);
+
+    const auto l = detached.at("t").at("b").location();
+    const auto r = original.at("t").at("b").location();
+    CHECK_EQ(l.file_name(),           r.file_name());
+    CHECK_EQ(l.first_line_number(),   r.first_line_number());
+    CHECK_EQ(l.first_column_number(), r.first_column_number());
+    CHECK_EQ(l.last_line_number(),    r.last_line_number());
+    CHECK_EQ(l.last_column_number(),  r.last_column_number());
+    CHECK_EQ(l.lines(), std::vector<std::string>{""});
+
+    const auto d = detached.at("t").at("c").at("d").location();
+    CHECK_EQ(d.first_line_number(),   6);
+    CHECK_EQ(d.first_column_number(), 10);
+    CHECK_NE(toml::format_error("error", detached.at("t").at("c").at("d"), "here")
+             .find(" 6 | \n   |          ^-- here\n"), std::string::npos);
+}
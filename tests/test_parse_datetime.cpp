@@ -51,6 +51,28 @@ TEST_CASE("testing offset_datetime")
             ),
             comments(), fmt(toml::datetime_delimiter_kind::upper_T, true, 6), ctx);
 
+        toml11_test_parse_success<toml::value_t::offset_datetime>(
+            "2000-02-29T23:59:59.5+05:45",
+            toml::offset_datetime(
+                toml::local_datetime(
+                    toml::local_date(2000, toml::month_t::Feb, 29),
+                    toml::local_time(23, 59, 59, 500)
+                ),
+                toml::time_offset(5, 45)
+            ),
+            comments(), fmt(toml::datetime_delimiter_kind::upper_T, true, 1), ctx);
+
+        toml11_test_parse_success<toml::value_t::offset_datetime>(
+            "1979-05-27T07:32:00-09:30",
+            toml::offset_datetime(
+                toml::local_datetime(
+                    toml::local_date(1979, toml::month_t::May, 27),
+                    toml::local_time(7, 32, 0)
+                ),
+                toml::time_offset(-9, -30)
+            ),
+            comments(), fmt(toml::datetime_delimiter_kind::upper_T, true, 0), ctx);
+
 
 
         toml11_test_parse_success<toml::value_t::offset_datetime>(
@@ -285,6 +307,9 @@ TEST_CASE("testing local_time")
         toml11_test_parse_success<toml::value_t::local_time>("01:23:45.1234",      toml::local_time(1, 23, 45, 123, 400),      comments(), fmt(true, 4), ctx);
         toml11_test_parse_success<toml::value_t::local_time>("01:23:45.1234567",   toml::local_time(1, 23, 45, 123, 456, 700), comments(), fmt(true, 7), ctx);
         toml11_test_parse_success<toml::value_t::local_time>("01:23:45.123456789", toml::local_time(1, 23, 45, 123, 456, 789), comments(), fmt(true, 9), ctx);
+        // digits after nanoseconds are truncated
+        toml11_test_parse_success<toml::value_t::local_time>("01:23:45.12345678987", toml::local_time(1, 23, 45, 123, 456, 789), comments(), fmt(true, 11), ctx);
+        toml11_test_parse_success<toml::value_t::local_time>("23:59:60.000000001", toml::local_time(23, 59, 60, 0, 0, 1),      comments(), fmt(true, 9), ctx);
     }
 
     {
@@ -6,6 +6,9 @@
 #include <toml11/parser.hpp>
 #include <toml11/types.hpp>
 
+#include <cstdio>
+#include <cstring>
+
 TEST_CASE("testing fractional float")
 {
     toml::detail::context<toml::type_config> ctx(toml::spec::v(1,0,0));
@@ -165,3 +168,57 @@ TEST_CASE("testing hexfloat")
         CHECK_EQ(val.as_floating(), 343.5);
     }
 }
+
+TEST_CASE("testing read_float is correctly rounded")
+{
+    const auto loc = toml::detail::make_temporary_location("0");
+    const toml::detail::region reg(loc);
+
+    const auto read_double = [&reg](const std::string& str) {
+        const auto res = toml::read_float<double>(str, reg, false);
+        REQUIRE_UNARY(res.is_ok());
+        return res.as_ok();
+    };
+    const auto read_single = [&reg](const std::string& str) {
+        const auto res = toml::read_float<float>(str, reg, false);
+        REQUIRE_UNARY(res.is_ok());
+        return res.as_ok();
+    };
+    const auto same_bits = [](const double x, const double y) {
+        return std::memcmp(&x, &y, sizeof(double)) == 0;
+    };
+
+    CHECK_UNARY(same_bits(read_double("0.1"),  0.1));
+    CHECK_UNARY(same_bits(read_double("-0.0"), -0.0));
+    CHECK_UNARY(same_bits(read_double("1e23"), 1e23));
+    CHECK_UNARY(same_bits(read_double("9007199254740993"), 9007199254740992.0));
+    CHECK_UNARY(same_bits(read_double("1.7976931348623157e308"), (std::numeric_limits<double>::max)()));
+    CHECK_UNARY(same_bits(read_double("2.2250738585072014e-308"), (std::numeric_limits<double>::min)()));
+    CHECK_UNARY(same_bits(read_double("4.9406564584124654e-324"), std::numeric_limits<double>::denorm_min()));
+    CHECK_UNARY(same_bits(read_double("123456789012345678901234567890"), 123456789012345678901234567890.0));
+    // the exact halfway point between 1 and the next double and values around it
+    CHECK_UNARY(same_bits(read_double("1.00000000000000011102230246251565404236316680908203125"), 1.0));
+    CHECK_UNARY(same_bits(read_double("1.00000000000000011102230246251565404236316680908203126"), 1.0000000000000002));
+
+    CHECK_EQ(read_single("3.4028235e38"), (std::numeric_limits<float>::max)());
+    CHECK_EQ(read_single("1.17549435e-38"), (std::numeric_limits<float>::min)());
+    CHECK_EQ(read_single("0.1"), 0.1f);
+
+    CHECK_UNARY(toml::read_float<double>("1e400", reg, false).is_err());
+
+    // round-trip
+    std::uint64_t state = 88172645463325252u;
+    for(std::size_t i=0; i<10000; ++i)
+    {
+        state ^= state << 13; state ^= state >> 7; state ^= state << 17;
+        double x;
+        std::memcpy(&x, &state, sizeof(double));
+        if(std::isnan(x) || std::isinf(x))
+        {
+            continue;
+        }
+        char buf[64];
+        std::snprintf(buf, sizeof(buf), "%.17g", x);
+        CHECK_MESSAGE(same_bits(read_double(buf), x), buf);
+    }
+}
@@ -128,6 +128,111 @@ TEST_CASE("testing integer_overflow")
     }
 }
 
+TEST_CASE("testing read_int boundary values")
+{
+    const auto loc = toml::detail::make_temporary_location("0");
+    const toml::detail::region reg(loc);
+
+    const auto ok_value = [&reg](const std::string& str, std::uint8_t base) {
+        const auto res = toml::read_int<std::int64_t>(str, reg, base);
+        REQUIRE_UNARY(res.is_ok());
+        return res.as_ok();
+    };
+    const auto is_error = [&reg](const std::string& str, std::uint8_t base) {
+        return toml::read_int<std::int64_t>(str, reg, base).is_err();
+    };
+
+    CHECK_EQ(ok_value( "9223372036854775807", 10), (std::numeric_limits<std::int64_t>::max)());
+    CHECK_EQ(ok_value("+9223372036854775807", 10), (std::numeric_limits<std::int64_t>::max)());
+    CHECK_EQ(ok_value("-9223372036854775808", 10), (std::numeric_limits<std::int64_t>::min)());
+    CHECK_EQ(ok_value("-0000000000000000001", 10), -1);
+    CHECK_EQ(ok_value("7FFFFFFFFFFFFFFF",     16), (std::numeric_limits<std::int64_t>::max)());
+    CHECK_EQ(ok_value("7fffffffffffffff",     16), (std::numeric_limits<std::int64_t>::max)());
+    CHECK_EQ(ok_value("777777777777777777777", 8), (std::numeric_limits<std::int64_t>::max)());
+
+    CHECK_UNARY(is_error( "9223372036854775808", 10));
+    CHECK_UNARY(is_error("-9223372036854775809", 10));
+    CHECK_UNARY(is_error("99999999999999999999", 10));
+    CHECK_UNARY(is_error("8000000000000000",     16));
+    CHECK_UNARY(is_error("1000000000000000000000", 8));
+    CHECK_UNARY(is_error("12a", 10));
+    CHECK_UNARY(is_error("-", 10));
+
+    {
+        const auto res = toml::read_int<std::uint8_t>("255", reg, 10);
+        REQUIRE_UNARY(res.is_ok());
+        CHECK_EQ(res.as_ok(), 255);
+        CHECK_UNARY(toml::read_int<std::uint8_t>("256", reg, 10).is_err());
+    }
+    {
+        const auto res = toml::read_int<std::int16_t>("-8000", reg, 16);
+        REQUIRE_UNARY(res.is_ok());
+        CHECK_EQ(res.as_ok(), -0x8000);
+        CHECK_UNARY(toml::read_int<std::int16_t>("8000", reg, 16).is_err());
+    }
+    {
+        const auto res = toml::read_int<std::uint64_t>("FFFFFFFFFFFFFFFF", reg, 16);
+        REQUIRE_UNARY(res.is_ok());
+        CHECK_EQ(res.as_ok(), (std::numeric_limits<std::uint64_t>::max)());
+        CHECK_UNARY(toml::read_int<std::uint64_t>("10000000000000000", reg, 16).is_err());
+    }
+}
+
+namespace
+{
+// integers that are not built-in signed types are passed to parse_int
+struct unsigned_type_config : toml::type_config
+{
+    using integer_type = std::uint64_t;
+
+    static std::string passed;
+
+    static toml::result<integer_type, toml::error_info>
+    parse_int(const std::string& str, const toml::detail::region& reg, const std::uint8_t base)
+    {
+        passed = str;
+        return toml::read_int<integer_type>(str, reg, base);
+    }
+};
+std::string unsigned_type_config::passed;
+} // anonymous
+
+TEST_CASE("testing integer boundary values in parser")
+{
+    toml::detail::context<toml::type_config> ctx(toml::spec::v(1,0,0));
+    const auto parse = [&ctx](const std::string& str) {
+        auto loc = toml::detail::make_temporary_location(str);
+        return toml::detail::parse_integer(loc, ctx);
+    };
+    const auto max = (std::numeric_limits<std::int64_t>::max)();
+    const auto min = (std::numeric_limits<std::int64_t>::min)();
+
+    CHECK_EQ(parse( "9_223_372_036_854_775_807").unwrap().as_integer(), max);
+    CHECK_EQ(parse("-9_223_372_036_854_775_808").unwrap().as_integer(), min);
+    CHECK_EQ(parse("0x7FFF_FFFF_FFFF_FFFF").unwrap().as_integer(), max);
+    CHECK_EQ(parse("0o777_777_777_777_777_777_777").unwrap().as_integer(), max);
+    CHECK_EQ(parse("0b0111111111111111111111111111111111111111111111111111111111111111").unwrap().as_integer(), max);
+
+    CHECK_UNARY(parse("-9_223_372_036_854_775_809").is_err());
+    CHECK_UNARY(parse("0b1_0000000000000000000000000000000000000000000000000000000000000000").is_err());
+
+    const auto res = parse("99999999999999999999");
+    REQUIRE_UNARY(res.is_err());
+    CHECK_NE(res.as_err().title().find("too large integer"), std::string::npos);
+
+    {
+        toml::detail::context<unsigned_type_config> uctx(toml::spec::v(1,0,0));
+        auto loc = toml::detail::make_temporary_location("0x00_ff_FF");
+        const auto v = toml::detail::parse_integer(loc, uctx);
+        REQUIRE_UNARY(v.is_ok());
+        CHECK_EQ(unsigned_type_config::passed, "ffFF");
+        CHECK_EQ(v.as_ok().as_integer(), 0xFFFF);
+        CHECK_EQ(v.as_ok().as_integer_fmt().width,  6);
+        CHECK_EQ(v.as_ok().as_integer_fmt().spacer, 2);
+        CHECK_UNARY(v.as_ok().as_integer_fmt().uppercase);
+    }
+}
+
 TEST_CASE("testing decimal_value with suffix extension")
 {
     auto spec = toml::spec::v(1, 0, 0);
@@ -161,6 +161,63 @@ TEST_CASE("testing multiline basic string")
     );
 }
 
+TEST_CASE("testing basic string with and without escape sequences")
+{
+    toml::detail::context<toml::type_config> ctx(toml::spec::v(1,0,0));
+    const auto parse = [&ctx](const std::string& in, std::size_t& consumed) {
+        auto loc = toml::detail::make_temporary_location(in);
+        const auto res = toml::detail::parse_string(loc, ctx);
+        consumed = loc.get_location();
+        return res;
+    };
+
+    // put the special characters around the boundaries of 16 and 32-byte blocks
+    for(std::size_t n=0; n<70; ++n)
+    {
+        const std::string body(n, 'a');
+        std::size_t consumed = 0;
+        {
+            const auto res = parse("\"" + body + "\xE3\x81\x82\" = 1", consumed);
+            REQUIRE_UNARY(res.is_ok());
+            CHECK_EQ(res.unwrap().as_string(), body + "\xE3\x81\x82");
+            CHECK_EQ(consumed, n + 5);
+            CHECK_EQ(res.unwrap().location().length(), n + 5);
+        }
+        {
+            const auto res = parse("\"" + body + "\\t\\u00E9b\" = 1", consumed);
+            REQUIRE_UNARY(res.is_ok());
+            CHECK_EQ(res.unwrap().as_string(), body + "\t\xC3\xA9" "b");
+            CHECK_EQ(consumed, n + 11);
+        }
+        CHECK_UNARY(parse("\"" + body + "\x01\"", consumed).is_err());
+        CHECK_UNARY(parse("\"" + body + "\n\"", consumed).is_err());
+        CHECK_UNARY(parse("\"" + body, consumed).is_err());
+
+        {
+            const auto res = parse("\"\"\"\r\n" + body + "\r\n\"\"b\"\"\"\"\" = 1", consumed);
+            REQUIRE_UNARY(res.is_ok());
+            CHECK_EQ(res.unwrap().as_string(), body + "\r\n\"\"b\"\"");
+            CHECK_UNARY(res.unwrap().as_string_fmt().start_with_newline);
+            CHECK_EQ(consumed, n + 15);
+        }
+        {
+            const auto res = parse("\"\"\"" + body + "\\\n  \t\n c\\\\\"\"\"", consumed);
+            REQUIRE_UNARY(res.is_ok());
+            CHECK_EQ(res.unwrap().as_string(), body + "c\\");
+            CHECK_UNARY( ! res.unwrap().as_string_fmt().start_with_newline);
+            CHECK_EQ(consumed, n + 16);
+        }
+        CHECK_UNARY(parse("\"\"\"" + body + "\r\"\"\"", consumed).is_err());
+        CHECK_UNARY(parse("\"\"\"" + body + "\"\"", consumed).is_err());
+    }
+
+    // an invalid escape sequence is reported at the actual location
+    const auto res = toml::try_parse_str("a = \"\"\"\nabc\n  \\uD800\"\"\"\n");
+    REQUIRE_UNARY(res.is_err());
+    REQUIRE_EQ(res.unwrap_err().at(0).locations().size(), 1);
+    CHECK_EQ(res.unwrap_err().at(0).locations().at(0).first.first_line_number(), 3);
+}
+
 TEST_CASE("testing literal_string")
 {
     toml::detail::context<toml::type_config> ctx(toml::spec::v(1,0,0));
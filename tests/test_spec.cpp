@@ -56,3 +56,18 @@ TEST_CASE("testing the ordering of semantic_version")
     CHECK(v121 >  v112);
     CHECK(v121 >= v112);
 }
+
+TEST_CASE("testing spec comparison ignores parser options")
+{
+    const auto s1 = toml::spec::v(1, 0, 0);
+    auto s2 = s1;
+    s2.memory_map_file = true;
+
+    CHECK(s1 == s2);
+    CHECK_FALSE(s1 != s2);
+    CHECK_FALSE(s1 <  s2);
+    CHECK_FALSE(s2 <  s1);
+
+    s2.ext_null_value = true;
+    CHECK(s1 != s2);
+}
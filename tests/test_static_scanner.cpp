@@ -0,0 +1,286 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include "utility.hpp"
+
+#include <toml11/skip.hpp>
+#include <toml11/static_syntax.hpp>
+#include <toml11/syntax.hpp>
+
+TEST_CASE("testing static_scanner: combinators")
+{
+    namespace ss = toml::detail::static_scanner;
+    using toml::detail::static_scan;
+    using toml::detail::static_skip;
+
+    const auto spec = toml::spec::v(1,0,0);
+    {
+        auto loc = toml::detail::make_temporary_location("\t \tA");
+        using tab   = ss::character<'\t'>;
+        using space = ss::character<' '>;
+
+        CHECK_UNARY( static_skip<tab  >(loc, spec));
+        CHECK_UNARY(!static_skip<tab  >(loc, spec));
+        CHECK_UNARY( static_skip<space>(loc, spec));
+        CHECK_UNARY( static_skip<tab  >(loc, spec));
+        CHECK_UNARY(!static_skip<tab  >(loc, spec));
+        CHECK_EQ(loc.current(), 'A');
+    }
+    {
+        auto loc = toml::detail::make_temporary_location("truefalse");
+        using true_ = ss::literal<'t','r','u','e'>;
+
+        const auto reg = static_scan<true_>(loc, spec);
+        REQUIRE_UNARY(reg.is_ok());
+        CHECK_EQ(reg.as_string(), "true");
+        CHECK_UNARY(!static_scan<true_>(loc, spec).is_ok());
+        CHECK_EQ(loc.get_location(), 4);
+    }
+    {
+        // an empty match is still a match
+        auto loc = toml::detail::make_temporary_location("");
+        CHECK_UNARY( static_skip<ss::maybe<ss::character<'a'>>>(loc, spec));
+        CHECK_UNARY( static_skip<ss::repeat_at_least<0, ss::character<'a'>>>(loc, spec));
+        CHECK_UNARY(!static_skip<ss::repeat_at_least<1, ss::character<'a'>>>(loc, spec));
+    }
+    {
+        // sequence rewinds on failure
+        auto loc = toml::detail::make_temporary_location("aab");
+        using aaa = ss::sequence<ss::character<'a'>, ss::repeat_exact<2, ss::character<'a'>>>;
+        using aab = ss::sequence<ss::character<'a'>, ss::either<ss::literal<'a','a'>, ss::literal<'a','b'>>>;
+        CHECK_UNARY(!static_skip<aaa>(loc, spec));
+        CHECK_EQ(loc.get_location(), 0);
+        CHECK_UNARY( static_skip<aab>(loc, spec));
+        CHECK_UNARY( loc.eof());
+    }
+}
+
+namespace
+{
+template<typename Scanner>
+void check_same_as_runtime(const toml::detail::scanner_base& runtime,
+                           const toml::spec& s, const std::string& str)
+{
+    // the static scanners assume that the input is already validated as UTF-8
+    const auto first = reinterpret_cast<const unsigned char*>(str.data());
+    if(toml::detail::find_invalid_utf8(first, first + str.size()) != first + str.size())
+    {
+        return;
+    }
+
+    auto loc_rt = toml::detail::make_temporary_location(str);
+    auto loc_st = loc_rt;
+
+    const auto reg_rt = runtime.scan(loc_rt);
+    const auto reg_st = toml::detail::static_scan<Scanner>(loc_st, s);
+
+    const auto what = runtime.name() + " with `" + str + "`";
+    CHECK_MESSAGE(reg_rt.is_ok()         == reg_st.is_ok(),         what);
+    CHECK_MESSAGE(loc_rt.get_location()  == loc_st.get_location(),  what);
+    CHECK_MESSAGE(loc_rt.line_number()   == loc_st.line_number(),   what);
+}
+} // anonymous
+
+TEST_CASE("testing static_syntax: the same as syntax")
+{
+    const std::vector<std::string> inputs = {
+        "", " ", "\t \t# comment\n", "\n", "\r\n", "\r", "# a \x7F\n", "# \x01\n",
+        "true", "false", "tru", "null",
+        "0", "+0", "-1_000", "01", "1__0", "123_", "0xDEAD_beef", "0x_1", "0o755", "0o8",
+        "0b1101", "0b2", "1_000_mm", "1.5_em", "1e3_\xCE\xBCm", "1_",
+        "3.14", "-1e-3", "1.", ".5", "6E+2", "1.0e", "inf", "+inf", "-nan", "0x1.8p3", "0x.8P-1", "0xp1",
+        "1979-05-27", "1979-05-27T07:32:00", "1979-05-27 07:32:00.999-07:00",
+        "1979-05-27t07:32Z", "07:32:00", "07:32", "7:32:00", "07:32:00+9:00",
+        "\"basic \\\"string\\\"\"", "\"\\u00E9\\U0001F600\\x41\\e\"", "\"unterminated",
+        "\"\"\"\nml\\\n  basic\"\"\"\"\"", "'literal'", "'''\nml\nliteral'''''", "'''a'''",
+        "bare-key_1", "\"quoted\".bare . 'lit'", "a.", "a..b", "\xC3\xA9t\xC3\xA9", "\xE2\x82\xAC",
+        "\xE3\x81\x82.b", "\xC3", "\xF0\x9F\x98", "[table]", "[ a . b ]", "[[aot]]", "[[ a.b ]]", "[a",
+        " = ", "=", " . ",
+    };
+
+    auto v11 = toml::spec::v(1,1,0);
+    v11.ext_allow_control_characters_in_comments = true;
+    v11.ext_allow_non_english_in_bare_keys = true;
+    v11.ext_hex_float = true;
+    v11.ext_num_suffix = true;
+
+    for(const auto& s : {toml::spec::v(1,0,0), v11})
+    {
+        namespace rt = toml::detail::syntax;
+        namespace st = toml::detail::static_syntax;
+
+        for(const auto& str : inputs)
+        {
+            check_same_as_runtime<st::ws               >(rt::ws               (s), s, str);
+            check_same_as_runtime<st::newline          >(rt::newline          (s), s, str);
+            check_same_as_runtime<st::comment          >(rt::comment          (s), s, str);
+            check_same_as_runtime<st::boolean          >(rt::boolean          (s), s, str);
+            check_same_as_runtime<st::num_suffix       >(rt::num_suffix       (s), s, str);
+            check_same_as_runtime<st::integer          >(rt::integer          (s), s, str);
+            check_same_as_runtime<st::floating         >(rt::floating         (s), s, str);
+            check_same_as_runtime<st::hex_floating     >(rt::hex_floating     (s), s, str);
+            check_same_as_runtime<st::local_date       >(rt::local_date       (s), s, str);
+            check_same_as_runtime<st::local_time       >(rt::local_time       (s), s, str);
+            check_same_as_runtime<st::time_offset      >(rt::time_offset      (s), s, str);
+            check_same_as_runtime<st::local_datetime   >(rt::local_datetime   (s), s, str);
+            check_same_as_runtime<st::offset_datetime  >(rt::offset_datetime  (s), s, str);
+            check_same_as_runtime<st::string           >(rt::string           (s), s, str);
+            check_same_as_runtime<st::escaped_newline  >(rt::escaped_newline  (s), s, str);
+            check_same_as_runtime<st::unquoted_key     >(rt::unquoted_key     (s), s, str);
+            check_same_as_runtime<st::dotted_key       >(rt::dotted_key       (s), s, str);
+            check_same_as_runtime<st::keyval_sep       >(rt::keyval_sep       (s), s, str);
+            check_same_as_runtime<st::std_table        >(rt::std_table        (s), s, str);
+            check_same_as_runtime<st::array_table      >(rt::array_table      (s), s, str);
+            check_same_as_runtime<st::null_value       >(rt::null_value       (s), s, str);
+        }
+    }
+}
+
+TEST_CASE("testing static_scanner: FIRST set")
+{
+    namespace ss = toml::detail::static_scanner;
+    namespace st = toml::detail::static_syntax;
+
+    using string_first = ss::first_set<st::string>;
+    CHECK_UNARY( string_first::contains('"'));
+    CHECK_UNARY( string_first::contains('\''));
+    CHECK_UNARY(!string_first::contains('a'));
+    CHECK_UNARY(!st::string::nullable);
+
+    using integer_first = ss::first_set<st::integer>;
+    for(int c = 0; c < 256; ++c)
+    {
+        const auto ch = static_cast<unsigned char>(c);
+        const bool expected = ('0' <= c && c <= '9') || c == '+' || c == '-';
+        CHECK_EQ(integer_first::contains(ch), expected);
+    }
+
+    // ws in front of `=` is nullable
+    CHECK_UNARY(ss::first_set<st::exponent_part>::contains('e'));
+    CHECK_UNARY(ss::first_set<st::keyval_sep>::contains('='));
+    CHECK_UNARY(ss::first_set<st::keyval_sep>::contains(' '));
+    CHECK_UNARY(st::ws::nullable);
+
+    // a multibyte codepoint starts with a leading byte, not a continuation
+    CHECK_UNARY( ss::first_set<st::non_ascii_key_char>::contains(0xC3));
+    CHECK_UNARY( ss::first_set<st::non_ascii_key_char>::contains(0xF4));
+    CHECK_UNARY(!ss::first_set<st::non_ascii_key_char>::contains(0x80));
+    CHECK_UNARY(!ss::first_set<st::non_ascii_key_char>::contains(0xFF));
+
+    // in a validated input, any non-ASCII byte is a part of a character
+    CHECK_UNARY( ss::first_set<st::non_ascii>::contains(0x80));
+    CHECK_UNARY(!ss::first_set<st::non_ascii>::contains(0x7F));
+}
+
+TEST_CASE("testing static_syntax: ws and comment across blocks")
+{
+    namespace rt = toml::detail::syntax;
+    namespace st = toml::detail::static_syntax;
+
+    auto v11 = toml::spec::v(1,1,0);
+    v11.ext_allow_control_characters_in_comments = true;
+
+    // put a character that stops or continues the run at every offset
+    // around the boundaries of 16 and 32-byte blocks.
+    const std::vector<std::string> stoppers = {
+        "x", "\n", "\r\n", "\x01", "\x7F", "\xC3\xA9", "\xE2\x82\xAC", "\xF0\x9F\x98\x80", "\t", " "
+    };
+    for(const auto& s : {toml::spec::v(1,0,0), v11})
+    {
+        for(std::size_t n=0; n<70; ++n)
+        {
+            for(const auto& stop : stoppers)
+            {
+                const auto ws      = std::string(n, ' ') + "\t" + stop + "  ";
+                const auto comment = "#" + std::string(n, 'c') + stop + "cc\t";
+                check_same_as_runtime<st::ws     >(rt::ws     (s), s, ws);
+                check_same_as_runtime<st::comment>(rt::comment(s), s, comment);
+            }
+        }
+    }
+}
+
+TEST_CASE("testing find_invalid_utf8")
+{
+    const auto invalid_at = [](const std::string& str) -> std::size_t {
+        const auto first = reinterpret_cast<const unsigned char*>(str.data());
+        return static_cast<std::size_t>(
+            toml::detail::find_invalid_utf8(first, first + str.size()) - first);
+    };
+
+    CHECK_EQ(invalid_at(""), 0);
+    CHECK_EQ(invalid_at("ascii"), 5);
+    CHECK_EQ(invalid_at("\xC3\xA9 \xE2\x82\xAC \xF0\x9F\x98\x80 \xF4\x8F\xBF\xBF"), 16);
+    CHECK_EQ(invalid_at("\xED\x9F\xBF \xEE\x80\x80"), 7); // around surrogates
+
+    CHECK_EQ(invalid_at("a\x80"),             1); // stray continuation byte
+    CHECK_EQ(invalid_at("a\xC0\xAF"),         1); // overlong
+    CHECK_EQ(invalid_at("a\xE0\x9F\xBF"),     1); // overlong
+    CHECK_EQ(invalid_at("a\xF0\x8F\xBF\xBF"), 1); // overlong
+    CHECK_EQ(invalid_at("a\xED\xA0\x80"),     1); // surrogate
+    CHECK_EQ(invalid_at("a\xF4\x90\x80\x80"), 1); // > U+10FFFF
+    CHECK_EQ(invalid_at("a\xF5\x80\x80\x80"), 1);
+    CHECK_EQ(invalid_at("a\xFF"),             1);
+    CHECK_EQ(invalid_at("a\xE2\x82"),         1); // cut at the end
+    CHECK_EQ(invalid_at("a\xE2\x82x"),        1);
+
+    // at every offset around the boundaries of 16 and 32-byte blocks
+    for(std::size_t n=0; n<70; ++n)
+    {
+        CHECK_EQ(invalid_at(std::string(n, 'a') + "\xE3\x81\x82" + std::string(40, 'b')), n + 43);
+        CHECK_EQ(invalid_at(std::string(n, 'a') + "\xE3\x81" + std::string(40, 'b')), n);
+        CHECK_EQ(invalid_at(std::string(n, 'a') + "\xE3\x81\x82\xBF" + std::string(40, 'b')), n + 3);
+    }
+
+    // in a run of multi-byte characters, an error in every position
+    std::string cjk;
+    for(std::size_t i=0; i<40; ++i)
+    {
+        cjk += (i % 3 == 0) ? "\xF0\x9F\x98\x80" : "\xE6\x97\xA5";
+    }
+    CHECK_EQ(invalid_at(cjk), cjk.size());
+    for(std::size_t n=0; n<cjk.size(); ++n)
+    {
+        // cut the character at n
+        std::size_t start = n;
+        while(start != 0 && (static_cast<unsigned char>(cjk.at(start)) & 0xC0) == 0x80)
+        {
+            --start;
+        }
+        if(start != n)
+        {
+            CHECK_EQ(invalid_at(cjk.substr(0, n) + "a" + cjk.substr(n)), start);
+        }
+        else // between characters
+        {
+            CHECK_EQ(invalid_at(cjk.substr(0, n) + "\xBF"     + cjk.substr(n)), n);
+            CHECK_EQ(invalid_at(cjk.substr(0, n) + "\xC0\x80" + cjk.substr(n)), n);
+            CHECK_EQ(invalid_at(cjk.substr(0, n) + "\xED\xA0\x80" + cjk.substr(n)), n);
+        }
+    }
+}
+
+TEST_CASE("testing skip: line numbers after comments")
+{
+    toml::detail::context<toml::type_config> ctx(toml::spec::v(1,0,0));
+    {
+        auto loc = toml::detail::make_temporary_location(
+            "# " + std::string(100, 'a') + "\n"
+            "   \t\n"
+            "\t# \xE3\x81\x82 " + std::string(40, '-') + "\r\n"
+            "key = 42\n");
+        toml::detail::skip_empty_or_comment_lines(loc, ctx);
+        CHECK_EQ(loc.current(), 'k');
+        CHECK_EQ(loc.line_number(),   4);
+        CHECK_EQ(loc.column_number(), 1);
+    }
+    {
+        // an invalid character in a comment, as in error recovery
+        auto loc = toml::detail::make_temporary_location(
+            "# " + std::string(50, 'a') + "\x01" + std::string(50, 'b') + "\n"
+            "    # no newline at the end");
+        toml::detail::skip_comment_block(loc, ctx);
+        CHECK_UNARY(loc.eof());
+        CHECK_EQ(loc.line_number(), 2);
+    }
+}
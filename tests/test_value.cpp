@@ -1296,3 +1296,28 @@ TEST_CASE("testing table-accessors")
     CHECK_UNARY(empty.contains("is"));
     CHECK_EQ(empty.at("is").as_string(), "table");
 }
+
+namespace
+{
+struct size_test_config : toml::type_config
+{
+    using comment_type = toml::discard_comments;
+    static constexpr bool track_location = false;
+};
+} // anonymous
+
+TEST_CASE("testing size of basic_value")
+{
+    // It is the largest part of the memory used by a document. Do not make it
+    // larger without a good reason. The budgets are for 64-bit platforms.
+    constexpr bool is_64bit = sizeof(void*) == 8;
+
+    static_assert( ! is_64bit || sizeof(toml::detail::region)    <= 24, "");
+    static_assert( ! is_64bit || sizeof(toml::preserve_comments) <=  8, "");
+    static_assert( ! is_64bit || sizeof(toml::value)             <= 80, "");
+    static_assert( ! is_64bit || sizeof(toml::basic_value<size_test_config>) <= 56, "");
+
+    // the type tag and the union of the values with their format
+    static_assert( ! is_64bit || sizeof(toml::value) - sizeof(toml::detail::region) -
+                   sizeof(toml::preserve_comments) <= 48, "");
+}
@@ -139,16 +139,7 @@ int main(int argc, char** argv)
         }
         else
         {
-            std::vector<unsigned char> buf;
-            std::cin.peek();
-
-            while(!std::cin.eof())
-            {
-                buf.push_back(static_cast<unsigned char>(std::cin.get()));
-                std::cin.peek();
-            }
-
-            const auto data = toml::parse(buf, "cin", TOML11_TO_JSON_SPEC);
+            const auto data = toml::parse(std::cin, "cin", TOML11_TO_JSON_SPEC);
             std::cout << toml::visit(json_converter<>(), data);
             return 0;
         }